@@ -2,22 +2,30 @@
 
 // Quantization
 #include "quantization/bounded_range.h"
+#include "quantization/bounded_range_d.h"
 #include "quantization/half_precision.h"
+#include "quantization/octahedral_normal.h"
 #include "quantization/smallest_three.h"
 
 // Stream
 #include "stream/bit_measure.h"
 #include "stream/bit_reader.h"
 #include "stream/bit_writer.h"
+#include "stream/buffer_pool.h"
 #include "stream/byte_buffer.h"
+#include "stream/segmented_buffer.h"
 #include "stream/serialize_traits.h"
 
 // Traits
 #include "traits/array_traits.h"
 #include "traits/bool_trait.h"
+#include "traits/cached_trait.h"
 #include "traits/checksum_trait.h"
+#include "traits/delta_traits.h"
+#include "traits/elias_fano_trait.h"
 #include "traits/enum_trait.h"
 #include "traits/float_trait.h"
 #include "traits/integral_traits.h"
+#include "traits/predicted_traits.h"
 #include "traits/quantization_traits.h"
 #include "traits/string_traits.h"
\ No newline at end of file
@@ -22,8 +22,17 @@
  *  SOFTWARE.
  */
 
+#include "../utility/platform.h"
+
+#include <cstddef>
 #include <cstdint>
 
+#ifdef BS_AVX2
+#include <immintrin.h>
+#elif defined(BS_SSE2)
+#include <emmintrin.h>
+#endif // BS_AVX2
+
 namespace bitstream
 {
 	/**
@@ -73,6 +82,93 @@ namespace bitstream
             return adjusted;
         }
 
+        /**
+         * @brief Quantizes an array of floats, giving the same results as quantizing each value separately
+         * @param values The values to quantize
+         * @param quantized The array to store the quantized values in
+         * @param count The number of values
+        */
+        inline void quantize(const float* values, uint32_t* quantized, size_t count) const noexcept
+        {
+            size_t i = 0U;
+#ifdef BS_SSE2
+            // The conversion is signed, so ranges which need all 32 bits are left to the scalar path
+            if (m_BitsRequired < 32U)
+            {
+                float inverse_precision = 1.0f / m_Precision;
+#ifdef BS_AVX2
+                const __m256 min8 = _mm256_set1_ps(m_Min);
+                const __m256 max8 = _mm256_set1_ps(m_Max);
+                const __m256 inverse8 = _mm256_set1_ps(inverse_precision);
+                const __m256 half8 = _mm256_set1_ps(0.5f);
+                const __m256i mask8 = _mm256_set1_epi32(static_cast<int32_t>(m_Mask));
+                for (; i + 8U <= count; i += 8U)
+                {
+                    __m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(values + i), min8), max8);
+                    __m256 scaled = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(value, min8), inverse8), half8);
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(quantized + i), _mm256_and_si256(_mm256_cvttps_epi32(scaled), mask8));
+                }
+#endif // BS_AVX2
+                const __m128 min4 = _mm_set1_ps(m_Min);
+                const __m128 max4 = _mm_set1_ps(m_Max);
+                const __m128 inverse4 = _mm_set1_ps(inverse_precision);
+                const __m128 half4 = _mm_set1_ps(0.5f);
+                const __m128i mask4 = _mm_set1_epi32(static_cast<int32_t>(m_Mask));
+                for (; i + 4U <= count; i += 4U)
+                {
+                    __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(values + i), min4), max4);
+                    __m128 scaled = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(value, min4), inverse4), half4);
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(quantized + i), _mm_and_si128(_mm_cvttps_epi32(scaled), mask4));
+                }
+            }
+#endif // BS_SSE2
+            for (; i < count; i++)
+                quantized[i] = quantize(values[i]);
+        }
+
+        /**
+         * @brief Dequantizes an array of values, giving the same results as dequantizing each value separately
+         * @param data The quantized values, each of which should fit within get_bits_required() bits
+         * @param values The array to store the dequantized values in
+         * @param count The number of values
+        */
+        inline void dequantize(const uint32_t* data, float* values, size_t count) const noexcept
+        {
+            size_t i = 0U;
+#ifdef BS_SSE2
+            // The conversion is signed, so ranges which need all 32 bits are left to the scalar path
+            if (m_BitsRequired < 32U)
+            {
+#ifdef BS_AVX2
+                const __m256 min8 = _mm256_set1_ps(m_Min);
+                const __m256 max8 = _mm256_set1_ps(m_Max);
+                const __m256 precision8 = _mm256_set1_ps(m_Precision);
+                for (; i + 8U <= count; i += 8U)
+                {
+                    __m256 value = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+                    __m256 adjusted = _mm256_add_ps(_mm256_mul_ps(value, precision8), min8);
+
+                    _mm256_storeu_ps(values + i, _mm256_min_ps(_mm256_max_ps(adjusted, min8), max8));
+                }
+#endif // BS_AVX2
+                const __m128 min4 = _mm_set1_ps(m_Min);
+                const __m128 max4 = _mm_set1_ps(m_Max);
+                const __m128 precision4 = _mm_set1_ps(m_Precision);
+                for (; i + 4U <= count; i += 4U)
+                {
+                    __m128 value = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+                    __m128 adjusted = _mm_add_ps(_mm_mul_ps(value, precision4), min4);
+
+                    _mm_storeu_ps(values + i, _mm_min_ps(_mm_max_ps(adjusted, min4), max4));
+                }
+            }
+#endif // BS_SSE2
+            for (; i < count; i++)
+                values[i] = dequantize(data[i]);
+        }
+
 	private:
         constexpr inline static uint32_t log2(uint32_t value) noexcept
         {
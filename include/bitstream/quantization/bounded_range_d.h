@@ -0,0 +1,78 @@
+#pragma once
+#include "../utility/bits.h"
+
+#include <cstdint>
+
+namespace bitstream
+{
+	/**
+	 * @brief Class for quantizing double-precision floats into a range and precision, using up to 64 bits
+	*/
+	class bounded_range_d
+	{
+	public:
+		constexpr bounded_range_d() noexcept :
+			m_Min(0),
+			m_Max(0),
+			m_Precision(0),
+			m_BitsRequired(0),
+			m_Mask(0) {}
+
+		constexpr bounded_range_d(double min, double max, double precision) noexcept :
+			m_Min(min),
+			m_Max(max),
+			m_Precision(precision),
+			m_BitsRequired(get_bits_required(to_steps((m_Max - m_Min) * (1.0 / precision) + 0.5))),
+			m_Mask(m_BitsRequired < 64U ? (1ULL << m_BitsRequired) - 1U : ~0ULL) {}
+
+		constexpr inline double get_min() const noexcept { return m_Min; }
+		constexpr inline double get_max() const noexcept { return m_Max; }
+		constexpr inline double get_precision() const noexcept { return m_Precision; }
+		constexpr inline uint32_t get_bits_required() const noexcept { return m_BitsRequired; }
+
+		constexpr inline uint64_t quantize(double value) const noexcept
+		{
+			if (value < m_Min)
+				value = m_Min;
+			else if (value > m_Max)
+				value = m_Max;
+
+			return to_steps((value - m_Min) * (1.0 / m_Precision) + 0.5) & m_Mask;
+		}
+
+		constexpr inline double dequantize(uint64_t data) const noexcept
+		{
+			double adjusted = (static_cast<double>(data) * m_Precision) + m_Min;
+
+			if (adjusted < m_Min)
+				adjusted = m_Min;
+			else if (adjusted > m_Max)
+				adjusted = m_Max;
+
+			return adjusted;
+		}
+
+	private:
+		constexpr inline static uint64_t to_steps(double scaled) noexcept
+		{
+			// Converting 2^64 or more is undefined, so ranges with more steps than that are clamped to the last step
+			constexpr double max_steps = 18446744073709551616.0; // 2^64
+
+			return scaled < max_steps ? static_cast<uint64_t>(scaled) : ~0ULL;
+		}
+
+		constexpr inline static uint32_t get_bits_required(uint64_t steps) noexcept
+		{
+			// A range with a single step still needs 1 bit, like bounded_range
+			return steps > 0U ? utility::bits_to_represent(steps) : 1U;
+		}
+
+	private:
+		double m_Min;
+		double m_Max;
+		double m_Precision;
+
+		uint32_t m_BitsRequired;
+		uint64_t m_Mask;
+	};
+}
\ No newline at end of file
@@ -22,9 +22,16 @@
  *  SOFTWARE.
  */
 
+#include "../utility/platform.h"
+
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 
+#ifdef BS_F16C
+#include <immintrin.h>
+#endif // BS_F16C
+
 namespace bitstream
 {
 	/**
@@ -100,6 +107,11 @@ namespace bitstream
 					tmp = static_cast<uint32_t>((value & 0x8000) << 16);
 				}
 			}
+			else if ((value & 0X7C00) == 0X7C00)
+			{
+				// Infinity and NaN
+				tmp = ((static_cast<uint32_t>(value) & 0x8000) << 16) | 0X7F800000 | (mantissa << 13);
+			}
 			else
 			{
 				tmp = ((static_cast<uint32_t>(value) & 0x8000) << 16) | (((((static_cast<uint32_t>(value) >> 10) & 0X1F) - 15) + 127) << 23) | (mantissa << 13);
@@ -110,5 +122,75 @@ namespace bitstream
 
 			return result;
 		}
+
+		/**
+		 * @brief Quantizes an array of floats into half-precision.
+		 * Uses F16C when available, which gives the same results as quantizing each value separately, except for the payloads of NaNs
+		 * @param values The values to quantize
+		 * @param quantized The array to store the quantized values in
+		 * @param count The number of values
+		*/
+		inline static void quantize(const float* values, uint16_t* quantized, size_t count) noexcept
+		{
+			size_t i = 0U;
+#ifdef BS_F16C
+			for (; i + 8U <= count; i += 8U)
+			{
+				__m128i halfs = _mm256_cvtps_ph(_mm256_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(quantized + i), halfs);
+			}
+#endif // BS_F16C
+			for (; i < count; i++)
+				quantized[i] = quantize(values[i]);
+		}
+
+		/**
+		 * @brief Dequantizes an array of half-precision values.
+		 * Uses F16C when available, or a lookup table otherwise
+		 * @param data The half-precision values
+		 * @param values The array to store the dequantized values in
+		 * @param count The number of values
+		*/
+		inline static void dequantize(const uint16_t* data, float* values, size_t count) noexcept
+		{
+			size_t i = 0U;
+#ifdef BS_F16C
+			for (; i + 8U <= count; i += 8U)
+			{
+				__m128i halfs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+
+				_mm256_storeu_ps(values + i, _mm256_cvtph_ps(halfs));
+			}
+
+			for (; i < count; i++)
+				values[i] = dequantize(data[i]);
+#else // BS_F16C
+			const float* table = get_dequantize_table();
+
+			for (; i < count; i++)
+				values[i] = table[data[i]];
+#endif // BS_F16C
+		}
+
+	private:
+		inline static const float* get_dequantize_table() noexcept
+		{
+			// Built on first use, since 256KB is too much to evaluate at compile time
+			struct dequantize_table
+			{
+				float values[0x10000];
+
+				dequantize_table() noexcept
+				{
+					for (uint32_t i = 0U; i < 0x10000U; i++)
+						values[i] = dequantize(static_cast<uint16_t>(i));
+				}
+			};
+
+			static const dequantize_table table;
+
+			return table.values;
+		}
 	};
 }
\ No newline at end of file
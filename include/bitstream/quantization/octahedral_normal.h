@@ -0,0 +1,313 @@
+#pragma once
+#include "../utility/platform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+#if defined(BS_AVX2) || defined(BS_FMA)
+#include <immintrin.h>
+#elif defined(BS_SSE2)
+#include <emmintrin.h>
+#endif // BS_AVX2
+
+namespace bitstream
+{
+	/**
+	 * @brief A quantized representation of a unit vector, as coordinates on an octahedron
+	*/
+	struct quantized_normal
+	{
+		uint32_t u;
+		uint32_t v;
+
+		constexpr quantized_normal() noexcept :
+			u(0),
+			v(0) {}
+
+		constexpr quantized_normal(uint32_t x, uint32_t y) noexcept :
+			u(x), v(y) {}
+	};
+
+	/**
+	 * @brief Class for quantizing a user-specified unit vector into 2 * BitsPerElement bits using octahedral mapping.
+	 * The vector is projected onto an octahedron, whose lower half is folded over the upper half, giving 2 coordinates in [-1, 1]
+	 * @tparam T The vector-type to quantize
+	*/
+	template<typename T, size_t BitsPerElement = 12>
+	class octahedral_normal
+	{
+	public:
+		static_assert(BitsPerElement >= 2 && BitsPerElement <= 24, "BitsPerElement must be within [2, 24]");
+
+		inline static quantized_normal quantize(const T& vector) noexcept
+		{
+			float coordinates[2];
+			encode(vector[0], vector[1], vector[2], coordinates);
+
+			return { quantize_coordinate(coordinates[0]), quantize_coordinate(coordinates[1]) };
+		}
+
+		inline static T dequantize(const quantized_normal& data) noexcept
+		{
+			float components[3];
+			decode(dequantize_coordinate(data.u), dequantize_coordinate(data.v), components);
+
+			return T{ components[0], components[1], components[2] };
+		}
+
+		/**
+		 * @brief Quantizes unit vectors which are stored as one array per component, giving the same results as quantizing each vector separately
+		 * @param components The arrays of each component, in the same order as T's operator[]
+		 * @param quantized The arrays to store the quantized values in, in the order u, v
+		 * @param count The number of vectors
+		*/
+		inline static void quantize(const float* const (&components)[3], uint32_t* const (&quantized)[2], size_t count) noexcept
+		{
+			size_t i = 0U;
+#ifdef BS_AVX2
+			for (; i + 8U <= count; i += 8U)
+			{
+				__m256 x = _mm256_loadu_ps(components[0] + i);
+				__m256 y = _mm256_loadu_ps(components[1] + i);
+				__m256 z = _mm256_loadu_ps(components[2] + i);
+
+				// Project onto the octahedron
+				const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+				const __m256 zero = _mm256_setzero_ps();
+				const __m256 one = _mm256_set1_ps(1.0f);
+
+				__m256 l1 = _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(sign_bit, x), _mm256_andnot_ps(sign_bit, y)), _mm256_andnot_ps(sign_bit, z));
+				l1 = _mm256_blendv_ps(l1, one, _mm256_cmp_ps(l1, zero, _CMP_EQ_OQ));
+
+				__m256 px = _mm256_div_ps(x, l1);
+				__m256 py = _mm256_div_ps(y, l1);
+
+				// Fold the lower half over the upper half
+				__m256 fx = _mm256_sub_ps(one, _mm256_andnot_ps(sign_bit, py));
+				__m256 fy = _mm256_sub_ps(one, _mm256_andnot_ps(sign_bit, px));
+				fx = _mm256_blendv_ps(fx, _mm256_sub_ps(zero, fx), _mm256_cmp_ps(px, zero, _CMP_LT_OQ));
+				fy = _mm256_blendv_ps(fy, _mm256_sub_ps(zero, fy), _mm256_cmp_ps(py, zero, _CMP_LT_OQ));
+
+				__m256 below = _mm256_cmp_ps(z, zero, _CMP_LT_OQ);
+				px = _mm256_blendv_ps(px, fx, below);
+				py = _mm256_blendv_ps(py, fy, below);
+
+				const __m256 half = _mm256_set1_ps(0.5f);
+				const __m256 steps = _mm256_set1_ps(max_value);
+				__m256i u = _mm256_cvttps_epi32(multiply_add(multiply_add(px, half, half), steps, half));
+				__m256i v = _mm256_cvttps_epi32(multiply_add(multiply_add(py, half, half), steps, half));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(quantized[0] + i), u);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(quantized[1] + i), v);
+			}
+#endif // BS_AVX2
+#ifdef BS_SSE2
+			for (; i + 4U <= count; i += 4U)
+			{
+				__m128 x = _mm_loadu_ps(components[0] + i);
+				__m128 y = _mm_loadu_ps(components[1] + i);
+				__m128 z = _mm_loadu_ps(components[2] + i);
+
+				// Project onto the octahedron
+				const __m128 sign_bit = _mm_set1_ps(-0.0f);
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 one = _mm_set1_ps(1.0f);
+
+				__m128 l1 = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign_bit, x), _mm_andnot_ps(sign_bit, y)), _mm_andnot_ps(sign_bit, z));
+				l1 = select(_mm_cmpeq_ps(l1, zero), one, l1);
+
+				__m128 px = _mm_div_ps(x, l1);
+				__m128 py = _mm_div_ps(y, l1);
+
+				// Fold the lower half over the upper half
+				__m128 fx = _mm_sub_ps(one, _mm_andnot_ps(sign_bit, py));
+				__m128 fy = _mm_sub_ps(one, _mm_andnot_ps(sign_bit, px));
+				fx = select(_mm_cmplt_ps(px, zero), _mm_sub_ps(zero, fx), fx);
+				fy = select(_mm_cmplt_ps(py, zero), _mm_sub_ps(zero, fy), fy);
+
+				__m128 below = _mm_cmplt_ps(z, zero);
+				px = select(below, fx, px);
+				py = select(below, fy, py);
+
+				const __m128 half = _mm_set1_ps(0.5f);
+				const __m128 steps = _mm_set1_ps(max_value);
+				__m128i u = _mm_cvttps_epi32(multiply_add(multiply_add(px, half, half), steps, half));
+				__m128i v = _mm_cvttps_epi32(multiply_add(multiply_add(py, half, half), steps, half));
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(quantized[0] + i), u);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(quantized[1] + i), v);
+			}
+#endif // BS_SSE2
+			for (; i < count; i++)
+			{
+				float coordinates[2];
+				encode(components[0][i], components[1][i], components[2][i], coordinates);
+
+				quantized[0][i] = quantize_coordinate(coordinates[0]);
+				quantized[1][i] = quantize_coordinate(coordinates[1]);
+			}
+		}
+
+		/**
+		 * @brief Dequantizes unit vectors into one array per component, giving the same results as dequantizing each vector separately
+		 * @param quantized The arrays of quantized values, in the order u, v
+		 * @param components The arrays to store each component in, in the same order as T's operator[]
+		 * @param count The number of vectors
+		*/
+		inline static void dequantize(const uint32_t* const (&quantized)[2], float* const (&components)[3], size_t count) noexcept
+		{
+			size_t i = 0U;
+#ifdef BS_AVX2
+			for (; i + 8U <= count; i += 8U)
+			{
+				const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+				const __m256 zero = _mm256_setzero_ps();
+				const __m256 one = _mm256_set1_ps(1.0f);
+				const __m256 scale = _mm256_set1_ps(2.0f / max_value);
+				const __m256 minus_one = _mm256_set1_ps(-1.0f);
+
+				__m256 x = multiply_add(_mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(quantized[0] + i))), scale, minus_one);
+				__m256 y = multiply_add(_mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(quantized[1] + i))), scale, minus_one);
+				__m256 z = _mm256_sub_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign_bit, x)), _mm256_andnot_ps(sign_bit, y));
+
+				// Unfold the lower half, by moving each coordinate towards 0
+				__m256 t = _mm256_max_ps(_mm256_sub_ps(zero, z), zero);
+				__m256 negative_t = _mm256_sub_ps(zero, t);
+				x = _mm256_add_ps(x, _mm256_blendv_ps(t, negative_t, _mm256_cmp_ps(x, zero, _CMP_GE_OQ)));
+				y = _mm256_add_ps(y, _mm256_blendv_ps(t, negative_t, _mm256_cmp_ps(y, zero, _CMP_GE_OQ)));
+
+				__m256 length = _mm256_sqrt_ps(multiply_add(z, z, multiply_add(y, y, _mm256_mul_ps(x, x))));
+
+				_mm256_storeu_ps(components[0] + i, _mm256_div_ps(x, length));
+				_mm256_storeu_ps(components[1] + i, _mm256_div_ps(y, length));
+				_mm256_storeu_ps(components[2] + i, _mm256_div_ps(z, length));
+			}
+#endif // BS_AVX2
+#ifdef BS_SSE2
+			for (; i + 4U <= count; i += 4U)
+			{
+				const __m128 sign_bit = _mm_set1_ps(-0.0f);
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 one = _mm_set1_ps(1.0f);
+				const __m128 scale = _mm_set1_ps(2.0f / max_value);
+				const __m128 minus_one = _mm_set1_ps(-1.0f);
+
+				__m128 x = multiply_add(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(quantized[0] + i))), scale, minus_one);
+				__m128 y = multiply_add(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(quantized[1] + i))), scale, minus_one);
+				__m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_bit, x)), _mm_andnot_ps(sign_bit, y));
+
+				// Unfold the lower half, by moving each coordinate towards 0
+				__m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+				__m128 negative_t = _mm_sub_ps(zero, t);
+				x = _mm_add_ps(x, select(_mm_cmpge_ps(x, zero), negative_t, t));
+				y = _mm_add_ps(y, select(_mm_cmpge_ps(y, zero), negative_t, t));
+
+				__m128 length = _mm_sqrt_ps(multiply_add(z, z, multiply_add(y, y, _mm_mul_ps(x, x))));
+
+				_mm_storeu_ps(components[0] + i, _mm_div_ps(x, length));
+				_mm_storeu_ps(components[1] + i, _mm_div_ps(y, length));
+				_mm_storeu_ps(components[2] + i, _mm_div_ps(z, length));
+			}
+#endif // BS_SSE2
+			for (; i < count; i++)
+			{
+				float vector[3];
+				decode(dequantize_coordinate(quantized[0][i]), dequantize_coordinate(quantized[1][i]), vector);
+
+				for (uint32_t k = 0U; k < 3U; k++)
+					components[k][i] = vector[k];
+			}
+		}
+
+	private:
+		static constexpr float max_value = static_cast<float>((1U << BitsPerElement) - 1U);
+
+		inline static void encode(float x, float y, float z, float (&coordinates)[2]) noexcept
+		{
+			// Project onto the octahedron, where a zero vector maps to the center
+			float l1 = (std::abs(x) + std::abs(y)) + std::abs(z);
+			if (l1 == 0.0f)
+				l1 = 1.0f;
+
+			float px = x / l1;
+			float py = y / l1;
+
+			// Fold the lower half over the upper half
+			if (z < 0.0f)
+			{
+				float fx = 1.0f - std::abs(py);
+				float fy = 1.0f - std::abs(px);
+
+				px = px < 0.0f ? 0.0f - fx : fx;
+				py = py < 0.0f ? 0.0f - fy : fy;
+			}
+
+			coordinates[0] = px;
+			coordinates[1] = py;
+		}
+
+		inline static void decode(float x, float y, float (&components)[3]) noexcept
+		{
+			float z = (1.0f - std::abs(x)) - std::abs(y);
+
+			// Unfold the lower half, by moving each coordinate towards 0
+			float t = z < 0.0f ? 0.0f - z : 0.0f;
+			x += x >= 0.0f ? 0.0f - t : t;
+			y += y >= 0.0f ? 0.0f - t : t;
+
+			float length = std::sqrt(multiply_add(z, z, multiply_add(y, y, x * x)));
+
+			components[0] = x / length;
+			components[1] = y / length;
+			components[2] = z / length;
+		}
+
+		inline static uint32_t quantize_coordinate(float value) noexcept
+		{
+			return static_cast<uint32_t>(multiply_add(multiply_add(value, 0.5f, 0.5f), max_value, 0.5f));
+		}
+
+		inline static float dequantize_coordinate(uint32_t value) noexcept
+		{
+			return multiply_add(static_cast<float>(value), 2.0f / max_value, -1.0f);
+		}
+
+		// Every multiply-add goes through here, so the compiler can't contract the scalar path into FMAs differently from the SIMD paths
+		inline static float multiply_add(float x, float y, float z) noexcept
+		{
+#ifdef BS_FMA
+			return std::fma(x, y, z);
+#else // BS_FMA
+			return x * y + z;
+#endif // BS_FMA
+		}
+
+#ifdef BS_AVX2
+		inline static __m256 multiply_add(__m256 x, __m256 y, __m256 z) noexcept
+		{
+#ifdef BS_FMA
+			return _mm256_fmadd_ps(x, y, z);
+#else // BS_FMA
+			return _mm256_add_ps(_mm256_mul_ps(x, y), z);
+#endif // BS_FMA
+		}
+#endif // BS_AVX2
+
+#ifdef BS_SSE2
+		inline static __m128 select(__m128 mask, __m128 if_true, __m128 if_false) noexcept
+		{
+			return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+		}
+
+		inline static __m128 multiply_add(__m128 x, __m128 y, __m128 z) noexcept
+		{
+#ifdef BS_FMA
+			return _mm_fmadd_ps(x, y, z);
+#else // BS_FMA
+			return _mm_add_ps(_mm_mul_ps(x, y), z);
+#endif // BS_FMA
+		}
+#endif // BS_SSE2
+	};
+}
\ No newline at end of file
@@ -22,9 +22,18 @@
  *  SOFTWARE.
  */
 
+#include "../utility/platform.h"
+
+#include <cstddef>
 #include <cstdint>
 #include <cmath>
 
+#if defined(BS_AVX2) || defined(BS_FMA)
+#include <immintrin.h>
+#elif defined(BS_SSE2)
+#include <emmintrin.h>
+#endif // BS_AVX2
+
 namespace bitstream
 {
 	/**
@@ -60,6 +69,124 @@ namespace bitstream
 
 	public:
 		inline static quantized_quaternion quantize(const T& quaternion) noexcept
+		{
+			return quantize_components(quaternion);
+		}
+
+		inline static T dequantize(const quantized_quaternion& data) noexcept
+		{
+			float components[4];
+			dequantize_components(data, components);
+
+			return T{ components[0], components[1], components[2], components[3] };
+		}
+
+		/**
+		 * @brief Quantizes unit quaternions which are stored as one array per component, giving the same results as quantizing each quaternion separately
+		 * @param components The arrays of each component, in the same order as T's operator[]
+		 * @param quantized The arrays to store the quantized values in, in the order m, a, b, c
+		 * @param count The number of quaternions
+		*/
+		inline static void quantize(const float* const (&components)[4], uint32_t* const (&quantized)[4], size_t count) noexcept
+		{
+			size_t i = 0U;
+#ifdef BS_AVX2
+			for (; i + 8U <= count; i += 8U)
+			{
+				__m256 q[4];
+				for (uint32_t k = 0U; k < 4U; k++)
+					q[k] = _mm256_loadu_ps(components[k] + i);
+
+				__m256i m;
+				__m256 abc[3];
+				quantize_lanes(q, m, abc);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(quantized[0] + i), m);
+				for (uint32_t k = 0U; k < 3U; k++)
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(quantized[k + 1U] + i), _mm256_cvttps_epi32(abc[k]));
+			}
+#endif // BS_AVX2
+#ifdef BS_SSE2
+			for (; i + 4U <= count; i += 4U)
+			{
+				__m128 q[4];
+				for (uint32_t k = 0U; k < 4U; k++)
+					q[k] = _mm_loadu_ps(components[k] + i);
+
+				__m128i m;
+				__m128 abc[3];
+				quantize_lanes(q, m, abc);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(quantized[0] + i), m);
+				for (uint32_t k = 0U; k < 3U; k++)
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(quantized[k + 1U] + i), _mm_cvttps_epi32(abc[k]));
+			}
+#endif // BS_SSE2
+			for (; i < count; i++)
+			{
+				float quaternion[4]{ components[0][i], components[1][i], components[2][i], components[3][i] };
+
+				quantized_quaternion quantized_quat = quantize_components(quaternion);
+
+				quantized[0][i] = quantized_quat.m;
+				quantized[1][i] = quantized_quat.a;
+				quantized[2][i] = quantized_quat.b;
+				quantized[3][i] = quantized_quat.c;
+			}
+		}
+
+		/**
+		 * @brief Dequantizes quaternions into one array per component, giving the same results as dequantizing each quaternion separately
+		 * @param quantized The arrays of quantized values, in the order m, a, b, c
+		 * @param components The arrays to store each component in, in the same order as T's operator[]
+		 * @param count The number of quaternions
+		*/
+		inline static void dequantize(const uint32_t* const (&quantized)[4], float* const (&components)[4], size_t count) noexcept
+		{
+			size_t i = 0U;
+#ifdef BS_AVX2
+			for (; i + 8U <= count; i += 8U)
+			{
+				__m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(quantized[0] + i));
+				__m256 abc[3];
+				for (uint32_t k = 0U; k < 3U; k++)
+					abc[k] = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(quantized[k + 1U] + i)));
+
+				__m256 q[4];
+				dequantize_lanes(m, abc, q);
+
+				for (uint32_t k = 0U; k < 4U; k++)
+					_mm256_storeu_ps(components[k] + i, q[k]);
+			}
+#endif // BS_AVX2
+#ifdef BS_SSE2
+			for (; i + 4U <= count; i += 4U)
+			{
+				__m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(quantized[0] + i));
+				__m128 abc[3];
+				for (uint32_t k = 0U; k < 3U; k++)
+					abc[k] = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(quantized[k + 1U] + i)));
+
+				__m128 q[4];
+				dequantize_lanes(m, abc, q);
+
+				for (uint32_t k = 0U; k < 4U; k++)
+					_mm_storeu_ps(components[k] + i, q[k]);
+			}
+#endif // BS_SSE2
+			for (; i < count; i++)
+			{
+				float quaternion[4];
+				dequantize_components({ quantized[0][i], quantized[1][i], quantized[2][i], quantized[3][i] }, quaternion);
+
+				for (uint32_t k = 0U; k < 4U; k++)
+					components[k][i] = quaternion[k];
+			}
+		}
+
+	private:
+		template<typename Q>
+		inline static quantized_quaternion quantize_components(const Q& quaternion) noexcept
 		{
 			constexpr float half_range = static_cast<float>(1 << (BitsPerElement - 1));
 			constexpr float packer = SMALLEST_THREE_PACK * half_range;
@@ -115,42 +242,205 @@ namespace bitstream
 
 			if (sign_minus)
 			{
-				a = static_cast<uint32_t>((-af * packer) + half_range);
-				b = static_cast<uint32_t>((-bf * packer) + half_range);
-				c = static_cast<uint32_t>((-cf * packer) + half_range);
+				a = static_cast<uint32_t>(multiply_add(-af, packer, half_range));
+				b = static_cast<uint32_t>(multiply_add(-bf, packer, half_range));
+				c = static_cast<uint32_t>(multiply_add(-cf, packer, half_range));
 			}
 			else
 			{
-				a = static_cast<uint32_t>((af * packer) + half_range);
-				b = static_cast<uint32_t>((bf * packer) + half_range);
-				c = static_cast<uint32_t>((cf * packer) + half_range);
+				a = static_cast<uint32_t>(multiply_add(af, packer, half_range));
+				b = static_cast<uint32_t>(multiply_add(bf, packer, half_range));
+				c = static_cast<uint32_t>(multiply_add(cf, packer, half_range));
 			}
 
 			return { m, a, b, c };
 		}
 
-		inline static T dequantize(const quantized_quaternion& data) noexcept
+		inline static void dequantize_components(const quantized_quaternion& data, float (&components)[4]) noexcept
 		{
 			constexpr uint32_t half_range = (1 << (BitsPerElement - 1));
 			constexpr float unpacker = SMALLEST_THREE_UNPACK * (1.0f / half_range);
             
-			float a = static_cast<float>(data.a * unpacker - half_range * unpacker);
-			float b = static_cast<float>(data.b * unpacker - half_range * unpacker);
-			float c = static_cast<float>(data.c * unpacker - half_range * unpacker);
+			float a = multiply_add(static_cast<float>(data.a), unpacker, -(half_range * unpacker));
+			float b = multiply_add(static_cast<float>(data.b), unpacker, -(half_range * unpacker));
+			float c = multiply_add(static_cast<float>(data.c), unpacker, -(half_range * unpacker));
 
-			float d = std::sqrt(1.0f - ((a * a) + (b * b) + (c * c)));
+			float d = std::sqrt(1.0f - multiply_add(c, c, multiply_add(b, b, a * a)));
 
 			switch (data.m)
 			{
 			case 0:
-				return T{ d, a, b, c };
+				components[0] = d; components[1] = a; components[2] = b; components[3] = c;
+				break;
 			case 1:
-				return T{ a, d, b, c };
+				components[0] = a; components[1] = d; components[2] = b; components[3] = c;
+				break;
 			case 2:
-				return T{ a, b, d, c };
+				components[0] = a; components[1] = b; components[2] = d; components[3] = c;
+				break;
 			default: // case 3
-				return T{ a, b, c, d };
+				components[0] = a; components[1] = b; components[2] = c; components[3] = d;
+				break;
+			}
+		}
+
+		// Every multiply-add goes through here, so the compiler can't contract the scalar path into FMAs differently from the SIMD paths
+		inline static float multiply_add(float x, float y, float z) noexcept
+		{
+#ifdef BS_FMA
+			return std::fma(x, y, z);
+#else // BS_FMA
+			return x * y + z;
+#endif // BS_FMA
+		}
+
+#ifdef BS_AVX2
+		inline static __m256 multiply_add(__m256 x, __m256 y, __m256 z) noexcept
+		{
+#ifdef BS_FMA
+			return _mm256_fmadd_ps(x, y, z);
+#else // BS_FMA
+			return _mm256_add_ps(_mm256_mul_ps(x, y), z);
+#endif // BS_FMA
+		}
+
+		inline static void quantize_lanes(const __m256 (&q)[4], __m256i& m, __m256 (&abc)[3]) noexcept
+		{
+			constexpr float half_range = static_cast<float>(1 << (BitsPerElement - 1));
+			constexpr float packer = SMALLEST_THREE_PACK * half_range;
+
+			const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+
+			// Find the first largest component in each lane, the same way as the scalar loop
+			__m256 max_value = _mm256_set1_ps(-1.0f);
+			__m256 largest = _mm256_setzero_ps();
+			m = _mm256_setzero_si256();
+			for (uint32_t k = 0U; k < 4U; k++)
+			{
+				__m256 abs = _mm256_andnot_ps(sign_bit, q[k]);
+				__m256 greater = _mm256_cmp_ps(abs, max_value, _CMP_GT_OQ);
+
+				max_value = _mm256_blendv_ps(max_value, abs, greater);
+				largest = _mm256_blendv_ps(largest, q[k], greater);
+				m = _mm256_blendv_epi8(m, _mm256_set1_epi32(static_cast<int32_t>(k)), _mm256_castps_si256(greater));
+			}
+
+			__m256 m_is_0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(m, _mm256_setzero_si256()));
+			__m256 m_above_1 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(m, _mm256_set1_epi32(1)));
+			__m256 m_above_2 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(m, _mm256_set1_epi32(2)));
+
+			// Negating a component is the same as flipping its sign bit
+			__m256 flip = _mm256_and_ps(_mm256_cmp_ps(largest, _mm256_setzero_ps(), _CMP_LT_OQ), sign_bit);
+
+			abc[0] = _mm256_blendv_ps(q[0], q[1], m_is_0);
+			abc[1] = _mm256_blendv_ps(q[2], q[1], m_above_1);
+			abc[2] = _mm256_blendv_ps(q[3], q[2], m_above_2);
+
+			for (uint32_t k = 0U; k < 3U; k++)
+				abc[k] = multiply_add(_mm256_xor_ps(abc[k], flip), _mm256_set1_ps(packer), _mm256_set1_ps(half_range));
+		}
+
+		inline static void dequantize_lanes(__m256i m, const __m256 (&abc)[3], __m256 (&q)[4]) noexcept
+		{
+			constexpr uint32_t half_range = (1 << (BitsPerElement - 1));
+			constexpr float unpacker = SMALLEST_THREE_UNPACK * (1.0f / half_range);
+
+			__m256 a = multiply_add(abc[0], _mm256_set1_ps(unpacker), _mm256_set1_ps(-(half_range * unpacker)));
+			__m256 b = multiply_add(abc[1], _mm256_set1_ps(unpacker), _mm256_set1_ps(-(half_range * unpacker)));
+			__m256 c = multiply_add(abc[2], _mm256_set1_ps(unpacker), _mm256_set1_ps(-(half_range * unpacker)));
+
+			__m256 sum = multiply_add(c, c, multiply_add(b, b, _mm256_mul_ps(a, a)));
+			__m256 d = _mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), sum));
+
+			__m256 m_is_0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(m, _mm256_setzero_si256()));
+			__m256 m_is_1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(m, _mm256_set1_epi32(1)));
+			__m256 m_is_2 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(m, _mm256_set1_epi32(2)));
+			__m256 m_above_1 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(m, _mm256_set1_epi32(1)));
+			__m256 m_above_2 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(m, _mm256_set1_epi32(2)));
+
+			q[0] = _mm256_blendv_ps(a, d, m_is_0);
+			q[1] = _mm256_blendv_ps(_mm256_blendv_ps(b, d, m_is_1), a, m_is_0);
+			q[2] = _mm256_blendv_ps(b, _mm256_blendv_ps(c, d, m_is_2), m_above_1);
+			q[3] = _mm256_blendv_ps(c, d, m_above_2);
+		}
+#endif // BS_AVX2
+
+#ifdef BS_SSE2
+		inline static __m128 select(__m128 mask, __m128 if_true, __m128 if_false) noexcept
+		{
+			return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+		}
+
+		inline static __m128 multiply_add(__m128 x, __m128 y, __m128 z) noexcept
+		{
+#ifdef BS_FMA
+			return _mm_fmadd_ps(x, y, z);
+#else // BS_FMA
+			return _mm_add_ps(_mm_mul_ps(x, y), z);
+#endif // BS_FMA
+		}
+
+		inline static void quantize_lanes(const __m128 (&q)[4], __m128i& m, __m128 (&abc)[3]) noexcept
+		{
+			constexpr float half_range = static_cast<float>(1 << (BitsPerElement - 1));
+			constexpr float packer = SMALLEST_THREE_PACK * half_range;
+
+			const __m128 sign_bit = _mm_set1_ps(-0.0f);
+
+			// Find the first largest component in each lane, the same way as the scalar loop
+			__m128 max_value = _mm_set1_ps(-1.0f);
+			__m128 largest = _mm_setzero_ps();
+			__m128 index = _mm_setzero_ps();
+			for (uint32_t k = 0U; k < 4U; k++)
+			{
+				__m128 abs = _mm_andnot_ps(sign_bit, q[k]);
+				__m128 greater = _mm_cmpgt_ps(abs, max_value);
+
+				max_value = select(greater, abs, max_value);
+				largest = select(greater, q[k], largest);
+				index = select(greater, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int32_t>(k))), index);
 			}
+
+			m = _mm_castps_si128(index);
+
+			__m128 m_is_0 = _mm_castsi128_ps(_mm_cmpeq_epi32(m, _mm_setzero_si128()));
+			__m128 m_above_1 = _mm_castsi128_ps(_mm_cmpgt_epi32(m, _mm_set1_epi32(1)));
+			__m128 m_above_2 = _mm_castsi128_ps(_mm_cmpgt_epi32(m, _mm_set1_epi32(2)));
+
+			// Negating a component is the same as flipping its sign bit
+			__m128 flip = _mm_and_ps(_mm_cmplt_ps(largest, _mm_setzero_ps()), sign_bit);
+
+			abc[0] = select(m_is_0, q[1], q[0]);
+			abc[1] = select(m_above_1, q[1], q[2]);
+			abc[2] = select(m_above_2, q[2], q[3]);
+
+			for (uint32_t k = 0U; k < 3U; k++)
+				abc[k] = multiply_add(_mm_xor_ps(abc[k], flip), _mm_set1_ps(packer), _mm_set1_ps(half_range));
+		}
+
+		inline static void dequantize_lanes(__m128i m, const __m128 (&abc)[3], __m128 (&q)[4]) noexcept
+		{
+			constexpr uint32_t half_range = (1 << (BitsPerElement - 1));
+			constexpr float unpacker = SMALLEST_THREE_UNPACK * (1.0f / half_range);
+
+			__m128 a = multiply_add(abc[0], _mm_set1_ps(unpacker), _mm_set1_ps(-(half_range * unpacker)));
+			__m128 b = multiply_add(abc[1], _mm_set1_ps(unpacker), _mm_set1_ps(-(half_range * unpacker)));
+			__m128 c = multiply_add(abc[2], _mm_set1_ps(unpacker), _mm_set1_ps(-(half_range * unpacker)));
+
+			__m128 sum = multiply_add(c, c, multiply_add(b, b, _mm_mul_ps(a, a)));
+			__m128 d = _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), sum));
+
+			__m128 m_is_0 = _mm_castsi128_ps(_mm_cmpeq_epi32(m, _mm_setzero_si128()));
+			__m128 m_is_1 = _mm_castsi128_ps(_mm_cmpeq_epi32(m, _mm_set1_epi32(1)));
+			__m128 m_is_2 = _mm_castsi128_ps(_mm_cmpeq_epi32(m, _mm_set1_epi32(2)));
+			__m128 m_above_1 = _mm_castsi128_ps(_mm_cmpgt_epi32(m, _mm_set1_epi32(1)));
+			__m128 m_above_2 = _mm_castsi128_ps(_mm_cmpgt_epi32(m, _mm_set1_epi32(2)));
+
+			q[0] = select(m_is_0, d, a);
+			q[1] = select(m_is_0, a, select(m_is_1, d, b));
+			q[2] = select(m_above_1, select(m_is_2, d, c), b);
+			q[3] = select(m_above_2, d, c);
 		}
+#endif // BS_SSE2
 	};
 }
\ No newline at end of file
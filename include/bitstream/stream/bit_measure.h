@@ -181,6 +181,24 @@ namespace bitstream
 			return true;
 		}
 
+		/**
+		 * @brief Writes the first @p num_bits bits of the 64-bit @p value into the buffer
+		 * @param value The value to serialize
+		 * @param num_bits The number of bits of the @p value to serialize
+		 * @return Returns false if @p num_bits is less than 1 or greater than 64 or if writing the given number of bits would overflow the buffer
+		*/
+		template<typename T, typename = std::enable_if_t<std::is_same_v<T, uint64_t>>>
+		[[nodiscard]] bool serialize_bits(T value, uint32_t num_bits) noexcept
+		{
+			BS_ASSERT(num_bits > 0U && num_bits <= 64U);
+
+			BS_ASSERT(can_serialize_bits(num_bits));
+
+			m_NumBitsWritten += num_bits;
+
+			return true;
+		}
+
 		/**
 		 * @brief Writes the first @p num_bits bits of the given byte array, 32 bits at a time
 		 * @param bytes The bytes to serialize
@@ -198,6 +216,21 @@ namespace bitstream
 			return true;
 		}
 
+		/**
+		 * @brief Writes whole words from another buffer
+		 * @param words The words to serialize, in the same byte order as the buffer of a stream
+		 * @param num_words The number of words to serialize
+		 * @return Returns false if writing the given number of words would overflow the buffer
+		*/
+		[[nodiscard]] bool serialize_words(const uint32_t* /*words*/, uint32_t num_words) noexcept
+		{
+			BS_ASSERT(can_serialize_bits(num_words * 32U));
+
+			m_NumBitsWritten += num_words * 32U;
+
+			return true;
+		}
+
 		/**
 		 * @brief Writes to the buffer, using the given @p Trait.
 		 * @note The Trait type in this function must always be explicitly declared
@@ -8,6 +8,7 @@
 #include "serialize_traits.h"
 #include "stream_traits.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <string>
@@ -23,6 +24,8 @@ namespace bitstream
 	class bit_reader
 	{
 	public:
+		using policy_type = Policy;
+
 		static constexpr bool writing = false;
 		static constexpr bool reading = true;
 
@@ -196,21 +199,56 @@ namespace bitstream
 				return true;
 			}*/
 
-			if (m_ScratchBits < num_bits)
-			{
-				const uint32_t* ptr = m_Policy.get_buffer() + m_WordIndex;
+			value = read_bits(num_bits);
 
-				uint64_t ptr_value = static_cast<uint64_t>(utility::to_big_endian32(*ptr)) << (32U - m_ScratchBits);
-				m_Scratch |= ptr_value;
-				m_ScratchBits += 32U;
-				m_WordIndex++;
+			return true;
+		}
+
+		/**
+		 * @brief Reads the first @p num_bits bits of the 64-bit @p value from the buffer, with only a single bounds check
+		 * @param value The value to serialize
+		 * @param num_bits The number of bits of the @p value to serialize
+		 * @return Returns false if @p num_bits is less than 1 or greater than 64 or if reading the given number of bits would overflow the buffer
+		*/
+		[[nodiscard]] bool serialize_bits(uint64_t& value, uint32_t num_bits) noexcept
+		{
+			BS_ASSERT(num_bits > 0U && num_bits <= 64U);
+
+			BS_ASSERT(m_Policy.extend(num_bits));
+
+			if (num_bits > 32U)
+			{
+				uint64_t high = read_bits(num_bits - 32U);
+				value = (high << 32U) | read_bits(32U);
+			}
+			else
+			{
+				value = read_bits(num_bits);
 			}
 
-			uint32_t offset = 64U - num_bits;
-			value = static_cast<uint32_t>(m_Scratch >> offset);
+			return true;
+		}
 
-			m_Scratch <<= num_bits;
-			m_ScratchBits -= num_bits;
+		/**
+		 * @brief Reads the next @p num_bits bits from the buffer into @p value, without advancing the stream.
+		 * Any bits past the end of the buffer are read as zeros
+		 * @param value The value to read into
+		 * @param num_bits The number of bits to peek at
+		 * @return Returns false if @p num_bits is less than 1 or greater than 32
+		*/
+		[[nodiscard]] bool peek_bits(uint32_t& value, uint32_t num_bits) noexcept
+		{
+			BS_ASSERT(num_bits > 0U && num_bits <= 32U);
+
+			// Only fetch the next word if it is part of the buffer
+			if (m_ScratchBits < num_bits && m_WordIndex * 32U < get_total_bits())
+				fill_scratch();
+
+			value = static_cast<uint32_t>(m_Scratch >> (64U - num_bits));
+
+			uint32_t remaining_bits = get_remaining_bits();
+			if (remaining_bits < num_bits)
+				value &= static_cast<uint32_t>(~((1ULL << (num_bits - remaining_bits)) - 1U));
 
 			return true;
 		}
@@ -231,14 +269,20 @@ namespace bitstream
             uint32_t* word_buffer = reinterpret_cast<uint32_t*>(bytes);
 			uint32_t num_words = num_bits / 32U;
             
-            if (m_ScratchBits % 32U == 0U && num_words > 0U)
+            if (m_ScratchBits == 0U && num_words > 0U)
             {
 				BS_ASSERT(m_Policy.extend(num_words * 32U));
 
-                // If the read buffer is word-aligned, just memcpy it
-                std::memcpy(word_buffer, m_Policy.get_buffer() + m_WordIndex, num_words * 4U);
-                
-                m_WordIndex += num_words;
+                // If the read buffer is word-aligned, just memcpy it, one run of words at a time
+                for (uint32_t i = 0U; i < num_words;)
+                {
+                    uint32_t run = static_cast<uint32_t>((std::min)(static_cast<size_t>(num_words - i), m_Policy.get_contiguous_words(m_WordIndex)));
+
+                    std::memcpy(word_buffer + i, m_Policy.get_word(m_WordIndex), run * 4U);
+
+                    i += run;
+                    m_WordIndex += run;
+                }
             }
             else
             {
@@ -302,6 +346,31 @@ namespace bitstream
 			return serialize_traits<utility::deduce_trait_t<Trait, bit_reader, Args...>>::serialize(*this, std::forward<Trait>(arg), std::forward<Args>(args)...);
 		}
 
+	private:
+		void fill_scratch() noexcept
+		{
+			const uint32_t* ptr = m_Policy.get_word(m_WordIndex);
+
+			uint64_t ptr_value = static_cast<uint64_t>(utility::to_big_endian32(*ptr)) << (32U - m_ScratchBits);
+			m_Scratch |= ptr_value;
+			m_ScratchBits += 32U;
+			m_WordIndex++;
+		}
+
+		uint32_t read_bits(uint32_t num_bits) noexcept
+		{
+			if (m_ScratchBits < num_bits)
+				fill_scratch();
+
+			uint32_t offset = 64U - num_bits;
+			uint32_t value = static_cast<uint32_t>(m_Scratch >> offset);
+
+			m_Scratch <<= num_bits;
+			m_ScratchBits -= num_bits;
+
+			return value;
+		}
+
 	private:
 		Policy m_Policy;
 
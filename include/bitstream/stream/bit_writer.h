@@ -3,16 +3,23 @@
 #include "../utility/crc.h"
 #include "../utility/endian.h"
 #include "../utility/meta.h"
+#include "../utility/platform.h"
 
 #include "byte_buffer.h"
 #include "serialize_traits.h"
 #include "stream_traits.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <type_traits>
 
+#ifdef BS_HAS_MEMORY_RESOURCE
+#include <memory_resource>
+#include <vector>
+#endif // BS_HAS_MEMORY_RESOURCE
+
 namespace bitstream
 {
 	/**
@@ -23,6 +30,8 @@ namespace bitstream
 	class bit_writer
 	{
 	public:
+		using policy_type = Policy;
+
 		static constexpr bool writing = true;
 		static constexpr bool reading = false;
 
@@ -114,7 +123,7 @@ namespace bitstream
 		{
 			if (m_ScratchBits > 0U)
 			{
-				uint32_t* ptr = m_Policy.get_buffer() + m_WordIndex;
+				uint32_t* ptr = m_Policy.get_word(m_WordIndex);
 				uint32_t ptr_value = static_cast<uint32_t>(m_Scratch >> 32U);
 				*ptr = utility::to_big_endian32(ptr_value);
 
@@ -143,7 +152,15 @@ namespace bitstream
             {
 				BS_ASSERT(m_Policy.extend(num_bytes * 8U - num_bits_written));
 
-                std::memset(m_Policy.get_buffer(), 0, num_bytes);
+				size_t num_words = (num_bytes + 3U) / 4U;
+				for (size_t index = 0U; index < num_words;)
+				{
+					size_t run = (std::min)(num_words - index, m_Policy.get_contiguous_words(index));
+
+					std::memset(m_Policy.get_word(index), 0, run * 4U);
+
+					index += run;
+				}
                 
                 m_Scratch = 0;
                 m_ScratchBits = 0;
@@ -221,20 +238,32 @@ namespace bitstream
 				return true;
 			}*/
 
-			uint32_t offset = 64U - num_bits - m_ScratchBits;
-			uint64_t ls_value = static_cast<uint64_t>(value) << offset;
+			write_bits(value, num_bits);
 
-			m_Scratch |= ls_value;
-			m_ScratchBits += num_bits;
+			return true;
+		}
 
-			if (m_ScratchBits >= 32U)
+		/**
+		 * @brief Writes the first @p num_bits bits of the 64-bit @p value into the buffer, with only a single bounds check
+		 * @param value The value to serialize
+		 * @param num_bits The number of bits of the @p value to serialize
+		 * @return Returns false if @p num_bits is less than 1 or greater than 64 or if writing the given number of bits would overflow the buffer
+		*/
+		template<typename T, typename = std::enable_if_t<std::is_same_v<T, uint64_t>>>
+		[[nodiscard]] bool serialize_bits(T value, uint32_t num_bits) noexcept
+		{
+			BS_ASSERT(num_bits > 0U && num_bits <= 64U);
+
+			BS_ASSERT(m_Policy.extend(num_bits));
+
+			if (num_bits > 32U)
 			{
-				uint32_t* ptr = m_Policy.get_buffer() + m_WordIndex;
-				uint32_t ptr_value = static_cast<uint32_t>(m_Scratch >> 32U);
-				*ptr = utility::to_big_endian32(ptr_value);
-				m_Scratch <<= 32ULL;
-				m_ScratchBits -= 32U;
-				m_WordIndex++;
+				write_bits(static_cast<uint32_t>(value >> 32U), num_bits - 32U);
+				write_bits(static_cast<uint32_t>(value), 32U);
+			}
+			else
+			{
+				write_bits(static_cast<uint32_t>(value), num_bits);
 			}
 
 			return true;
@@ -255,27 +284,8 @@ namespace bitstream
             // Write the byte array as words
             const uint32_t* word_buffer = reinterpret_cast<const uint32_t*>(bytes);
 			uint32_t num_words = num_bits / 32U;
-            
-            if (m_ScratchBits % 32U == 0U && num_words > 0U)
-            {
-				BS_ASSERT(m_Policy.extend(num_words * 32U));
 
-                // If the written buffer is word-aligned, just memcpy it
-                std::memcpy(m_Policy.get_buffer() + m_WordIndex, word_buffer, num_words * 4U);
-                
-                m_WordIndex += num_words;
-            }
-            else
-            {
-                // If the buffer is not word-aligned, serialize a word at a time
-                for (uint32_t i = 0U; i < num_words; i++)
-                {
-                    // Casting a byte-array to an int is wrong on little-endian systems
-                    // We have to swap the bytes around
-                    uint32_t value = utility::to_big_endian32(word_buffer[i]);
-                    BS_ASSERT(serialize_bits(value, 32U));
-                }
-            }
+			BS_ASSERT(serialize_words(word_buffer, num_words));
             
             // Early exit if the word-count matches
             if (num_bits % 32U == 0U)
@@ -293,29 +303,109 @@ namespace bitstream
 			return true;
 		}
 
+		/**
+		 * @brief Writes whole words from another buffer, shifting them into place with a single bounds check
+		 * @param words The words to serialize, in the same byte order as the buffer of a stream
+		 * @param num_words The number of words to serialize
+		 * @return Returns false if writing the given number of words would overflow the buffer
+		*/
+		[[nodiscard]] bool serialize_words(const uint32_t* words, uint32_t num_words) noexcept
+		{
+			if (num_words == 0U)
+				return true;
+
+			BS_ASSERT(m_Policy.extend(num_words * 32U));
+
+			// Policies which aren't contiguous are written one run of words at a time
+			while (num_words > 0U)
+			{
+				uint32_t run = static_cast<uint32_t>((std::min)(static_cast<size_t>(num_words), m_Policy.get_contiguous_words(m_WordIndex)));
+				uint32_t* ptr = m_Policy.get_word(m_WordIndex);
+
+				if (m_ScratchBits == 0)
+				{
+					// If the written buffer is word-aligned, just memcpy it
+					std::memcpy(ptr, words, run * 4U);
+				}
+				else
+				{
+					// Otherwise each word is split between the end of the scratch and the start of the next word
+					uint32_t offset = 32U - static_cast<uint32_t>(m_ScratchBits);
+					uint64_t scratch = m_Scratch;
+
+					for (uint32_t i = 0U; i < run; i++)
+					{
+						scratch |= static_cast<uint64_t>(utility::to_big_endian32(words[i])) << offset;
+						ptr[i] = utility::to_big_endian32(static_cast<uint32_t>(scratch >> 32U));
+						scratch <<= 32U;
+					}
+
+					m_Scratch = scratch;
+				}
+
+				words += run;
+				num_words -= run;
+				m_WordIndex += run;
+			}
+
+			return true;
+		}
+
 		/**
 		 * @brief Writes the contents of the buffer into the given @p writer. Essentially copies the entire buffer without modifying it.
+		 * The contents are copied a word at a time, regardless of the bit offset of the @p writer, and any bits which have not been flushed yet are included
 		 * @param writer The writer to copy into
 		 * @return Returns false if writing would overflow the buffer
 		*/
 		template<typename T>
 		[[nodiscard]] bool serialize_into(bit_writer<T>& writer) const noexcept
 		{
-			uint8_t* buffer = reinterpret_cast<uint8_t*>(m_Policy.get_buffer());
 			uint32_t num_bits = get_num_bits_serialized();
-			uint32_t remainder_bits = num_bits % 8U;
+			uint32_t num_words = num_bits / 32U;
+			uint32_t remainder_bits = num_bits % 32U;
 
-			BS_ASSERT(writer.serialize_bytes(buffer, num_bits - remainder_bits));
+			BS_ASSERT(writer.can_serialize_bits(num_bits));
+
+			for (uint32_t index = 0U; index < num_words;)
+			{
+				uint32_t run = static_cast<uint32_t>((std::min)(static_cast<size_t>(num_words - index), m_Policy.get_contiguous_words(index)));
+
+				BS_ASSERT(writer.serialize_words(m_Policy.get_word(index), run));
+
+				index += run;
+			}
 
 			if (remainder_bits > 0U)
 			{
-				uint32_t byte_value = buffer[num_bits / 8U] >> (8U - remainder_bits);
-				BS_ASSERT(writer.serialize_bits(byte_value, remainder_bits));
+				// The last bits are either still in the scratch, or in the last word if the buffer has been flushed
+				uint32_t value;
+				if (m_ScratchBits > 0)
+					value = static_cast<uint32_t>(m_Scratch >> (64U - remainder_bits));
+				else
+					value = utility::to_big_endian32(*m_Policy.get_word(num_words)) >> (32U - remainder_bits);
+
+				BS_ASSERT(writer.serialize_bits(value, remainder_bits));
 			}
 
 			return true;
 		}
 
+		/**
+		 * @brief Writes the contents of the buffer into each of the given @p writers, like a part of a snapshot which is shared between many clients.
+		 * This buffer is only read from, so the writers can also be split between multiple threads
+		 * @param writers The writers to copy into
+		 * @param count The number of writers
+		 * @return Returns false if writing would overflow any of the buffers, in which case the remaining writers are left untouched
+		*/
+		template<typename T>
+		[[nodiscard]] bool serialize_into(bit_writer<T>* writers, size_t count) const noexcept
+		{
+			for (size_t i = 0U; i < count; i++)
+				BS_ASSERT(serialize_into(writers[i]));
+
+			return true;
+		}
+
 		/**
 		 * @brief Writes to the buffer, using the given @p Trait.
 		 * @note The Trait type in this function must always be explicitly declared
@@ -346,6 +436,26 @@ namespace bitstream
 			return serialize_traits<utility::deduce_trait_t<Trait, bit_writer, Args...>>::serialize(*this, std::forward<Trait>(arg), std::forward<Args>(args)...);
 		}
 
+	private:
+		void write_bits(uint32_t value, uint32_t num_bits) noexcept
+		{
+			uint32_t offset = 64U - num_bits - m_ScratchBits;
+			uint64_t ls_value = static_cast<uint64_t>(value) << offset;
+
+			m_Scratch |= ls_value;
+			m_ScratchBits += num_bits;
+
+			if (m_ScratchBits >= 32U)
+			{
+				uint32_t* ptr = m_Policy.get_word(m_WordIndex);
+				uint32_t ptr_value = static_cast<uint32_t>(m_Scratch >> 32U);
+				*ptr = utility::to_big_endian32(ptr_value);
+				m_Scratch <<= 32ULL;
+				m_ScratchBits -= 32U;
+				m_WordIndex++;
+			}
+		}
+
 	private:
 		Policy m_Policy;
 
@@ -358,4 +468,16 @@ namespace bitstream
 
 	template<typename T>
 	using growing_bit_writer = bit_writer<growing_policy<T>>;
+
+	template<size_t Size>
+	using small_bit_writer = bit_writer<small_buffer_policy<Size>>;
+
+#ifdef BS_HAS_MEMORY_RESOURCE
+	/**
+	 * @brief A growing writer whose buffer allocates from a std::pmr::memory_resource.
+	 * Using a std::pmr::monotonic_buffer_resource for every writer in a frame turns each reallocation into a pointer bump,
+	 * and frees all of them at once when the resource is released
+	*/
+	using pmr_bit_writer = growing_bit_writer<std::pmr::vector<uint32_t>>;
+#endif // BS_HAS_MEMORY_RESOURCE
 }
\ No newline at end of file
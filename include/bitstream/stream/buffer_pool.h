@@ -0,0 +1,282 @@
+#pragma once
+#include "byte_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace bitstream
+{
+	/**
+	 * @brief A fixed number of preallocated byte buffers, which can be acquired and released from any thread without locking.
+	 * Buffers released on the thread which acquired them are kept in a small per-thread cache before going back to a global lock-free freelist,
+	 * so a thread which allocates and frees packets in a loop rarely touches shared memory.
+	 * Buffers released on any other thread go straight back to the freelist, so they are never stranded in a thread which doesn't acquire them
+	 * @tparam Size The size of each buffer in bytes. Must be a multiple of 4
+	 * @tparam Alignment The alignment of each buffer in bytes. Defaults to a cache line, so buffers used by different threads don't share one
+	 * @tparam CacheSize The maximum number of buffers each thread can keep in its cache. The cache is also limited to an eighth of the pool's capacity
+	*/
+	template<size_t Size, size_t Alignment = 64U, size_t CacheSize = 32U>
+	class buffer_pool
+	{
+	public:
+		static_assert(Alignment >= alignof(uint32_t) && (Alignment & (Alignment - 1U)) == 0U, "The alignment must be a power of 2, and at least 4 bytes");
+
+		/**
+		 * @brief An owning reference to a buffer in a pool, which returns the buffer when it is destroyed.
+		 * The buffer can be passed to fixed_bit_writer and fixed_bit_reader, or any other stream using a fixed_policy
+		*/
+		class handle
+		{
+		public:
+			handle() noexcept :
+				m_Pool(nullptr),
+				m_Cache(nullptr),
+				m_Index(null_index) {}
+
+			handle(handle&& other) noexcept :
+				m_Pool(std::exchange(other.m_Pool, nullptr)),
+				m_Cache(std::exchange(other.m_Cache, nullptr)),
+				m_Index(std::exchange(other.m_Index, null_index)) {}
+
+			handle(const handle&) = delete;
+
+			~handle()
+			{
+				reset();
+			}
+
+			handle& operator=(handle&& rhs) noexcept
+			{
+				if (this != &rhs)
+				{
+					reset();
+
+					m_Pool = std::exchange(rhs.m_Pool, nullptr);
+					m_Cache = std::exchange(rhs.m_Cache, nullptr);
+					m_Index = std::exchange(rhs.m_Index, null_index);
+				}
+
+				return *this;
+			}
+
+			handle& operator=(const handle&) = delete;
+
+			/**
+			 * @brief Returns the buffer to the pool, leaving this handle empty
+			*/
+			void reset() noexcept
+			{
+				if (m_Pool)
+					m_Pool->release(m_Index, m_Cache);
+
+				m_Pool = nullptr;
+				m_Cache = nullptr;
+				m_Index = null_index;
+			}
+
+			byte_buffer<Size>* get() const noexcept { return m_Pool ? &m_Pool->m_Blocks[m_Index].Buffer : nullptr; }
+
+			byte_buffer<Size>& operator*() const noexcept { return *get(); }
+
+			byte_buffer<Size>* operator->() const noexcept { return get(); }
+
+			explicit operator bool() const noexcept { return m_Pool != nullptr; }
+
+		private:
+			friend class buffer_pool;
+
+			handle(buffer_pool* pool, const void* cache, uint32_t index) noexcept :
+				m_Pool(pool),
+				m_Cache(cache),
+				m_Index(index) {}
+
+			buffer_pool* m_Pool;
+			const void* m_Cache; // The cache of the thread which acquired the buffer, only used to compare against
+			uint32_t m_Index;
+		};
+
+		/**
+		 * @brief Allocates all of the buffers in the pool up front
+		 * @param capacity The number of buffers in the pool
+		*/
+		explicit buffer_pool(uint32_t capacity) :
+			m_Blocks(new block[capacity]),
+			m_Freelist(std::make_shared<freelist>(capacity)),
+			m_Capacity(capacity),
+			m_CacheLimit((std::min)(static_cast<uint32_t>(CacheSize), capacity / 8U)) {}
+
+		buffer_pool(const buffer_pool&) = delete;
+
+		buffer_pool& operator=(const buffer_pool&) = delete;
+
+		/**
+		 * @brief Destroys the pool and its buffers. All handles must have been released
+		*/
+		~buffer_pool()
+		{
+			// Empty this thread's cache, so the next pool to release a buffer can take it over.
+			// Caches in other threads keep the freelist alive until they are taken over or their thread exits
+			thread_cache& cache = get_thread_cache();
+			if (cache.Freelist == m_Freelist)
+			{
+				cache.Count = 0U;
+				cache.Freelist.reset();
+			}
+		}
+
+		/**
+		 * @brief Takes a buffer from the pool. The contents of the buffer are not cleared
+		 * @return A handle to the buffer, or an empty handle if every buffer is in use
+		*/
+		handle acquire() noexcept
+		{
+			thread_cache& cache = get_thread_cache();
+			if (cache.Freelist == m_Freelist && cache.Count > 0U)
+				return handle(this, &cache, cache.Indices[--cache.Count]);
+
+			uint32_t index = m_Freelist->pop();
+			if (index == null_index)
+				return handle();
+
+			return handle(this, &cache, index);
+		}
+
+		/**
+		 * @brief Moves the buffers in this thread's cache back to the global freelist, so other threads can acquire them.
+		 * This also happens when the thread exits, but can be called earlier by a thread which stops using the pool
+		*/
+		void flush_thread_cache() noexcept
+		{
+			thread_cache& cache = get_thread_cache();
+			if (cache.Freelist == m_Freelist)
+				cache.flush();
+		}
+
+		/**
+		 * @brief Returns the total number of buffers in the pool, including those in use
+		*/
+		uint32_t get_capacity() const noexcept { return m_Capacity; }
+
+	private:
+		static constexpr uint32_t null_index = ~0U;
+
+		struct alignas(Alignment) block
+		{
+			byte_buffer<Size> Buffer;
+		};
+
+		// The head is a buffer index in the low 32 bits and a counter in the high 32 bits.
+		// The counter changes on every update, so a thread which read an old head can't swap it in after the index has been popped and pushed again (ABA)
+		struct freelist
+		{
+			explicit freelist(uint32_t capacity) :
+				Next(new std::atomic<uint32_t>[capacity]),
+				Head(capacity > 0U ? 0U : null_index)
+			{
+				// Link every buffer into the freelist, in order
+				for (uint32_t i = 0U; i < capacity; i++)
+					Next[i].store(i + 1U < capacity ? i + 1U : null_index, std::memory_order_relaxed);
+			}
+
+			void push(uint32_t index) noexcept
+			{
+				uint64_t head = Head.load(std::memory_order_relaxed);
+				uint64_t new_head;
+				do
+				{
+					Next[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+
+					new_head = (((head >> 32U) + 1U) << 32U) | index;
+				} while (!Head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			uint32_t pop() noexcept
+			{
+				uint64_t head = Head.load(std::memory_order_acquire);
+				uint64_t new_head;
+				uint32_t index;
+				do
+				{
+					index = static_cast<uint32_t>(head);
+					if (index == null_index)
+						return null_index;
+
+					// The link may be stale if another thread pops this buffer first, but then the counter won't match
+					uint32_t next = Next[index].load(std::memory_order_relaxed);
+
+					new_head = (((head >> 32U) + 1U) << 32U) | next;
+				} while (!Head.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire));
+
+				return index;
+			}
+
+			std::unique_ptr<std::atomic<uint32_t>[]> Next;
+			std::atomic<uint64_t> Head;
+		};
+
+		struct thread_cache
+		{
+			thread_cache() = default;
+
+			thread_cache(const thread_cache&) = delete;
+
+			thread_cache& operator=(const thread_cache&) = delete;
+
+			// Give the cached buffers back when the thread exits, so they can be used by other threads
+			~thread_cache()
+			{
+				if (Freelist)
+					flush();
+			}
+
+			void flush() noexcept
+			{
+				while (Count > 0U)
+					Freelist->push(Indices[--Count]);
+			}
+
+			// Shared with the pool, so a cache can still be flushed after its pool is destroyed
+			std::shared_ptr<freelist> Freelist;
+			uint32_t Count = 0U;
+			uint32_t Indices[CacheSize];
+		};
+
+		static thread_cache& get_thread_cache() noexcept
+		{
+			// A thread only caches buffers for one pool of each type at a time
+			static thread_local thread_cache cache;
+
+			return cache;
+		}
+
+		void release(uint32_t index, const void* owner) noexcept
+		{
+			thread_cache& cache = get_thread_cache();
+
+			// Buffers released on another thread are returned to the freelist, where the thread which acquired them can find them again
+			if (&cache != owner)
+			{
+				m_Freelist->push(index);
+				return;
+			}
+
+			// Take over the cache if it's empty, since it probably belonged to a pool which is no longer used
+			if (cache.Count == 0U && cache.Freelist != m_Freelist && m_CacheLimit > 0U)
+				cache.Freelist = m_Freelist;
+
+			if (cache.Freelist == m_Freelist && cache.Count < m_CacheLimit)
+				cache.Indices[cache.Count++] = index;
+			else
+				m_Freelist->push(index);
+		}
+
+		std::unique_ptr<block[]> m_Blocks;
+		std::shared_ptr<freelist> m_Freelist;
+		uint32_t m_Capacity;
+		uint32_t m_CacheLimit;
+	};
+}
\ No newline at end of file
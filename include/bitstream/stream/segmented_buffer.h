@@ -0,0 +1,278 @@
+#pragma once
+#include "../utility/platform.h"
+
+#include "bit_reader.h"
+#include "bit_writer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#ifdef BS_HAS_IOVEC
+#include <sys/uio.h>
+#endif // BS_HAS_IOVEC
+
+namespace bitstream
+{
+	/**
+	 * @brief A buffer made of fixed-size chunks, which are allocated as the buffer grows.
+	 * Unlike a single contiguous buffer, growing it never moves what has already been written,
+	 * and the chunks can be handed to scatter-gather I/O like writev and readv without copying them.
+	 * Chunks are kept when the buffer is reused, so a buffer which is kept around only allocates until it reaches its peak size.
+	 * Since the buffer isn't contiguous, streams using it have no get_buffer(), so checksum<Version> and elias_fano_view can't be used with them
+	 * @tparam ChunkSize The size of each chunk in bytes. Must be a power of 2, and at least 4
+	*/
+	template<size_t ChunkSize = 65536U>
+	class segmented_buffer
+	{
+	public:
+		static_assert(ChunkSize >= 4U && (ChunkSize & (ChunkSize - 1U)) == 0U, "The chunk size must be a power of 2, and at least 4 bytes");
+
+		static constexpr size_t words_per_chunk = ChunkSize / 4U;
+
+		segmented_buffer() = default;
+
+		segmented_buffer(const segmented_buffer&) = delete;
+
+		segmented_buffer(segmented_buffer&&) noexcept = default;
+
+		segmented_buffer& operator=(const segmented_buffer&) = delete;
+
+		segmented_buffer& operator=(segmented_buffer&&) noexcept = default;
+
+		/**
+		 * @brief Allocates enough chunks to hold @p num_bytes, like before reading into the buffer
+		 * @param num_bytes The number of bytes the buffer should be able to hold
+		*/
+		void reserve(size_t num_bytes)
+		{
+			size_t num_chunks = (num_bytes + ChunkSize - 1U) / ChunkSize;
+
+			while (m_Chunks.size() < num_chunks)
+				m_Chunks.emplace_back(new chunk);
+		}
+
+		/**
+		 * @brief Returns the number of bytes that the allocated chunks can hold
+		*/
+		size_t get_capacity() const noexcept { return m_Chunks.size() * ChunkSize; }
+
+		/**
+		 * @brief Returns the number of allocated chunks
+		*/
+		size_t get_num_chunks() const noexcept { return m_Chunks.size(); }
+
+		/**
+		 * @brief Returns the chunk at the given @p index, which is @p ChunkSize bytes long
+		*/
+		uint8_t* get_chunk(size_t index) const noexcept { return reinterpret_cast<uint8_t*>(m_Chunks[index]->Words); }
+
+		/**
+		 * @brief Returns the word at the given @p index in the buffer
+		*/
+		uint32_t* get_word(size_t index) const noexcept { return m_Chunks[index / words_per_chunk]->Words + index % words_per_chunk; }
+
+		/**
+		 * @brief Copies bytes from the given array into the buffer, allocating chunks as needed
+		 * @param bytes The bytes to copy
+		 * @param num_bytes The number of bytes to copy
+		 * @param offset The byte offset in the buffer to copy to
+		*/
+		void copy_from(const void* bytes, size_t num_bytes, size_t offset = 0U)
+		{
+			reserve(offset + num_bytes);
+
+			const uint8_t* source = static_cast<const uint8_t*>(bytes);
+			while (num_bytes > 0U)
+			{
+				size_t chunk_offset = offset % ChunkSize;
+				size_t run = (std::min)(num_bytes, ChunkSize - chunk_offset);
+
+				std::memcpy(get_chunk(offset / ChunkSize) + chunk_offset, source, run);
+
+				source += run;
+				offset += run;
+				num_bytes -= run;
+			}
+		}
+
+#ifdef BS_HAS_IOVEC
+		/**
+		 * @brief Fills @p vecs with the first @p num_bytes of the buffer, one iovec per chunk, to be used with writev or sendmsg.
+		 * If the buffer has been reserved, this can also be used with readv or recvmsg to read straight into the buffer
+		 * @param vecs The iovecs to fill
+		 * @param max_vecs The maximum number of iovecs to fill
+		 * @param num_bytes The number of bytes to cover, like the number of bytes written by a stream
+		 * @return The number of iovecs which were filled, or 0 if there are too few chunks or iovecs to cover @p num_bytes
+		*/
+		size_t get_iovecs(iovec* vecs, size_t max_vecs, size_t num_bytes) const noexcept
+		{
+			size_t num_vecs = (num_bytes + ChunkSize - 1U) / ChunkSize;
+			if (num_vecs > max_vecs || num_vecs > m_Chunks.size())
+				return 0U;
+
+			for (size_t i = 0U; i < num_vecs; i++)
+			{
+				vecs[i].iov_base = get_chunk(i);
+				vecs[i].iov_len = (std::min)(num_bytes - i * ChunkSize, ChunkSize);
+			}
+
+			return num_vecs;
+		}
+
+		/**
+		 * @brief Copies the contents of the given iovecs into the buffer, like after receiving a packet into buffers owned by something else
+		 * @param vecs The iovecs to copy from
+		 * @param num_vecs The number of iovecs
+		 * @return The total number of bytes copied
+		*/
+		size_t copy_from(const iovec* vecs, size_t num_vecs)
+		{
+			size_t offset = 0U;
+			for (size_t i = 0U; i < num_vecs; i++)
+			{
+				copy_from(vecs[i].iov_base, vecs[i].iov_len, offset);
+
+				offset += vecs[i].iov_len;
+			}
+
+			return offset;
+		}
+#endif // BS_HAS_IOVEC
+
+	private:
+		struct alignas(64) chunk
+		{
+			uint32_t Words[words_per_chunk];
+		};
+
+		std::vector<std::unique_ptr<chunk>> m_Chunks;
+	};
+
+	/**
+	 * @brief A policy for writing to a segmented_buffer, which allocates chunks as they are needed
+	 * @tparam ChunkSize The size of each chunk in bytes
+	*/
+	template<size_t ChunkSize>
+	struct segmented_policy
+	{
+		/**
+		 * @brief Construct a stream pointing to the given @p buffer, which can grow without bounds
+		 * @param buffer The buffer to serialize to
+		*/
+		segmented_policy(segmented_buffer<ChunkSize>& buffer) noexcept :
+			m_Buffer(&buffer),
+			m_NumBitsSerialized(0),
+			m_TotalBits((std::numeric_limits<uint32_t>::max)()) {}
+
+		/**
+		 * @brief Construct a stream pointing to the given @p buffer, which can grow up to @p num_bits
+		 * @param buffer The buffer to serialize to
+		 * @param num_bits The maximum number of bits that we can write
+		*/
+		segmented_policy(segmented_buffer<ChunkSize>& buffer, uint32_t num_bits) noexcept :
+			m_Buffer(&buffer),
+			m_NumBitsSerialized(0),
+			m_TotalBits(num_bits) {}
+
+		uint32_t* get_word(size_t index) const noexcept { return m_Buffer->get_word(index); }
+
+		// Words never cross a chunk boundary, since chunks are a whole number of words
+		size_t get_contiguous_words(size_t index) const noexcept { return segmented_buffer<ChunkSize>::words_per_chunk - index % segmented_buffer<ChunkSize>::words_per_chunk; }
+
+		uint32_t get_num_bits_serialized() const noexcept { return m_NumBitsSerialized; }
+
+		bool can_serialize_bits(uint32_t num_bits) const noexcept { return num_bits <= m_TotalBits - m_NumBitsSerialized; }
+
+		uint32_t get_total_bits() const noexcept { return m_TotalBits; }
+
+		bool extend(uint32_t num_bits)
+		{
+			if (!can_serialize_bits(num_bits))
+				return false;
+
+			m_NumBitsSerialized += num_bits;
+
+			// Allocate whole words, since they are written one at a time
+			size_t num_bytes = (static_cast<size_t>(m_NumBitsSerialized) + 31U) / 32U * 4U;
+			if (num_bytes > m_Buffer->get_capacity())
+				m_Buffer->reserve(num_bytes);
+
+			return true;
+		}
+
+		segmented_buffer<ChunkSize>* m_Buffer;
+		uint32_t m_NumBitsSerialized;
+		uint32_t m_TotalBits;
+	};
+
+	/**
+	 * @brief A policy for reading from a segmented_buffer, which is bounded by the chunks it has already allocated
+	 * @tparam ChunkSize The size of each chunk in bytes
+	*/
+	template<size_t ChunkSize>
+	struct segmented_read_policy
+	{
+		/**
+		 * @brief Construct a stream pointing to the given @p buffer, covering all of its chunks
+		 * @param buffer The buffer to serialize from
+		*/
+		segmented_read_policy(const segmented_buffer<ChunkSize>& buffer) noexcept :
+			m_Buffer(&buffer),
+			m_NumBitsSerialized(0),
+			m_TotalBits(get_capacity_bits(buffer)) {}
+
+		/**
+		 * @brief Construct a stream pointing to the given @p buffer
+		 * @param buffer The buffer to serialize from
+		 * @param num_bits The maximum number of bits that we can read. Clamped to the capacity of @p buffer
+		*/
+		segmented_read_policy(const segmented_buffer<ChunkSize>& buffer, uint32_t num_bits) noexcept :
+			m_Buffer(&buffer),
+			m_NumBitsSerialized(0),
+			m_TotalBits((std::min)(num_bits, get_capacity_bits(buffer))) {}
+
+		uint32_t* get_word(size_t index) const noexcept { return m_Buffer->get_word(index); }
+
+		// Words never cross a chunk boundary, since chunks are a whole number of words
+		size_t get_contiguous_words(size_t index) const noexcept { return segmented_buffer<ChunkSize>::words_per_chunk - index % segmented_buffer<ChunkSize>::words_per_chunk; }
+
+		uint32_t get_num_bits_serialized() const noexcept { return m_NumBitsSerialized; }
+
+		bool can_serialize_bits(uint32_t num_bits) const noexcept { return num_bits <= m_TotalBits - m_NumBitsSerialized; }
+
+		uint32_t get_total_bits() const noexcept { return m_TotalBits; }
+
+		// Never allocates, since reading past the chunks would only return uninitialized memory
+		bool extend(uint32_t num_bits) noexcept
+		{
+			if (!can_serialize_bits(num_bits))
+				return false;
+
+			m_NumBitsSerialized += num_bits;
+
+			return true;
+		}
+
+		static uint32_t get_capacity_bits(const segmented_buffer<ChunkSize>& buffer) noexcept
+		{
+			size_t max_bytes = (std::numeric_limits<uint32_t>::max)() / 8U;
+
+			return static_cast<uint32_t>((std::min)(buffer.get_capacity(), max_bytes) * 8U);
+		}
+
+		const segmented_buffer<ChunkSize>* m_Buffer;
+		uint32_t m_NumBitsSerialized;
+		uint32_t m_TotalBits;
+	};
+
+	template<size_t ChunkSize = 65536U>
+	using segmented_bit_writer = bit_writer<segmented_policy<ChunkSize>>;
+
+	template<size_t ChunkSize = 65536U>
+	using segmented_bit_reader = bit_reader<segmented_read_policy<ChunkSize>>;
+}
\ No newline at end of file
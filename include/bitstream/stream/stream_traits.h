@@ -4,8 +4,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace bitstream
 {
@@ -44,6 +47,11 @@ namespace bitstream
 
 		uint32_t* get_buffer() const noexcept { return m_Buffer; }
 
+		// The buffer is contiguous, so any number of words can be accessed from a word pointer
+		uint32_t* get_word(size_t index) const noexcept { return m_Buffer + index; }
+
+		size_t get_contiguous_words(size_t /*index*/) const noexcept { return (std::numeric_limits<size_t>::max)(); }
+
 		// TODO: Transition sizes to size_t
 		uint32_t get_num_bits_serialized() const noexcept { return m_NumBitsSerialized; }
 
@@ -75,9 +83,13 @@ namespace bitstream
 
 		uint32_t* get_buffer() const noexcept { return m_Buffer.data(); }
 
+		uint32_t* get_word(size_t index) const noexcept { return m_Buffer.data() + index; }
+
+		size_t get_contiguous_words(size_t /*index*/) const noexcept { return (std::numeric_limits<size_t>::max)(); }
+
 		uint32_t get_num_bits_serialized() const noexcept { return m_NumBitsSerialized; }
 
-		bool can_serialize_bits(uint32_t num_bits) const noexcept { return true; }
+		bool can_serialize_bits(uint32_t /*num_bits*/) const noexcept { return true; }
 
 		uint32_t get_total_bits() const noexcept { return (std::numeric_limits<uint32_t>::max)(); }
 
@@ -85,7 +97,10 @@ namespace bitstream
 		{
 			m_NumBitsSerialized += num_bits;
 			uint32_t num_bytes = (m_NumBitsSerialized - 1) / 8U + 1;
-			m_Buffer.resize(num_bytes);
+
+			// Only grow by the number of elements needed, which matters when the container allocates from an arena
+			constexpr size_t element_size = sizeof(typename T::value_type);
+			m_Buffer.resize((num_bytes + element_size - 1U) / element_size);
 			return true;
 		}
 
@@ -93,4 +108,101 @@ namespace bitstream
 
 		uint32_t m_NumBitsSerialized;
 	};
+
+	/**
+	 * @brief A growing policy which stores the first @p Size bytes inline, and only allocates on the heap if more than that is written.
+	 * Moving a stream using this policy copies the inline bytes
+	 * @tparam Size The number of bytes to store inline. Must be a multiple of 4
+	*/
+	template<size_t Size>
+	struct small_buffer_policy
+	{
+		static_assert(Size > 0U && Size % 4U == 0U, "Buffer size must be a multiple of 4");
+
+		small_buffer_policy() noexcept :
+			m_Buffer(m_Inline),
+			m_Capacity(Size / 4U),
+			m_NumBitsSerialized(0) {}
+
+		small_buffer_policy(const small_buffer_policy&) = delete;
+
+		small_buffer_policy(small_buffer_policy&& other) noexcept :
+			m_Buffer(m_Inline),
+			m_Capacity(Size / 4U),
+			m_NumBitsSerialized(0)
+		{
+			*this = std::move(other);
+		}
+
+		small_buffer_policy& operator=(const small_buffer_policy&) = delete;
+
+		small_buffer_policy& operator=(small_buffer_policy&& rhs) noexcept
+		{
+			if (this == &rhs)
+				return *this;
+
+			if (rhs.m_Heap)
+			{
+				m_Heap = std::move(rhs.m_Heap);
+				m_Buffer = m_Heap.get();
+			}
+			else
+			{
+				m_Heap.reset();
+				m_Buffer = m_Inline;
+				std::memcpy(m_Inline, rhs.m_Inline, get_num_words(rhs.m_NumBitsSerialized) * sizeof(uint32_t));
+			}
+
+			m_Capacity = rhs.m_Capacity;
+			m_NumBitsSerialized = rhs.m_NumBitsSerialized;
+
+			rhs.m_Buffer = rhs.m_Inline;
+			rhs.m_Capacity = Size / 4U;
+			rhs.m_NumBitsSerialized = 0;
+
+			return *this;
+		}
+
+		uint32_t* get_buffer() const noexcept { return m_Buffer; }
+
+		uint32_t* get_word(size_t index) const noexcept { return m_Buffer + index; }
+
+		size_t get_contiguous_words(size_t /*index*/) const noexcept { return (std::numeric_limits<size_t>::max)(); }
+
+		uint32_t get_num_bits_serialized() const noexcept { return m_NumBitsSerialized; }
+
+		bool can_serialize_bits(uint32_t /*num_bits*/) const noexcept { return true; }
+
+		uint32_t get_total_bits() const noexcept { return (std::numeric_limits<uint32_t>::max)(); }
+
+		bool extend(uint32_t num_bits)
+		{
+			uint32_t num_words = get_num_words(m_NumBitsSerialized + num_bits);
+
+			if (num_words > m_Capacity)
+			{
+				// Grow geometrically, so a large message only reallocates a few times
+				uint32_t capacity = m_Capacity * 2U > num_words ? m_Capacity * 2U : num_words;
+
+				std::unique_ptr<uint32_t[]> heap(new uint32_t[capacity]);
+				std::memcpy(heap.get(), m_Buffer, get_num_words(m_NumBitsSerialized) * sizeof(uint32_t));
+
+				m_Heap = std::move(heap);
+				m_Buffer = m_Heap.get();
+				m_Capacity = capacity;
+			}
+
+			m_NumBitsSerialized += num_bits;
+			return true;
+		}
+
+		constexpr static uint32_t get_num_words(uint32_t num_bits) noexcept { return (num_bits + 31U) / 32U; }
+
+		uint32_t m_Inline[Size / 4U];
+		std::unique_ptr<uint32_t[]> m_Heap;
+		uint32_t* m_Buffer;
+		uint32_t m_Capacity;
+
+		uint32_t m_NumBitsSerialized;
+	};
 }
\ No newline at end of file
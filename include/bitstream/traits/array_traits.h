@@ -1,5 +1,7 @@
 #pragma once
 #include "../utility/assert.h"
+#include "../utility/bitmask.h"
+#include "../utility/bits.h"
 #include "../utility/meta.h"
 #include "../utility/parameter.h"
 
@@ -8,7 +10,11 @@
 #include "../traits/bool_trait.h"
 #include "../traits/integral_traits.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
 
 namespace bitstream
 {
@@ -28,107 +34,206 @@ namespace bitstream
 	struct serialize_traits<array_subset<T, Trait>>
 	{
     private:
-        template<uint32_t Min, uint32_t Max, typename Stream>
-        static bool serialize_difference(Stream& stream, int& previous, int& current, uint32_t& difference)
+        // Differences in [2,125] are written as j zeros, followed by the difference + 2 in j + 2 bits, where j is in [1,5]
+        // A difference of 1 is just a single set bit, while six zeros are followed by the difference as a bounded integer in [126,max_size+1]
+        static constexpr uint32_t max_prefix_bits = 12U;
+
+        static uint32_t get_index_bits(uint32_t difference, int max_size) noexcept
         {
-            bool use_bits;
-            if constexpr (Stream::writing)
-                use_bits = difference <= Max;
-            BS_ASSERT(stream.template serialize<bool>(use_bits));
-            if (use_bits)
-            {
-                using bounded_trait = bounded_int<uint32_t, Min, Max>;
-
-                BS_ASSERT(stream.template serialize<bounded_trait>(difference));
-                if constexpr (Stream::reading)
-                    current = previous + difference;
-                previous = current;
-                return true;
-            }
+            if (difference == 1U)
+                return 1U;
+
+            if (difference < 126U)
+                return 2U * utility::bits_to_represent(difference + 2U) - 2U;
+
+            return 6U + utility::bits_in_range(126, max_size + 1);
+        }
+
+        template<typename Stream>
+        static bool write_index(Stream& writer, int& previous, int current, int max_size) noexcept
+        {
+            BS_ASSERT(previous < current);
+
+            uint32_t difference = static_cast<uint32_t>(current - previous);
+            previous = current;
+
+            if (difference < 126U)
+                return writer.serialize_bits(difference == 1U ? 1U : difference + 2U, get_index_bits(difference, max_size));
+
+            BS_ASSERT(writer.serialize_bits(0U, 6U));
 
-            return false;
+            return writer.template serialize<int_range<uint32_t>>(int_range<uint32_t>(126U, static_cast<uint32_t>(max_size) + 1U), difference);
         }
 
         template<typename Stream>
-        static bool serialize_index(Stream& stream, int& previous, int& current, int max_size)
+        static bool read_index(Stream& reader, int& previous, int max_size) noexcept
         {
+            // Find the length of the prefix from the upcoming bits, instead of reading it a bit at a time
+            uint32_t window;
+            BS_ASSERT(reader.peek_bits(window, max_prefix_bits));
+
+            uint32_t num_zeros = utility::count_leading_zeros64(window) - (64U - max_prefix_bits);
+
             uint32_t difference;
-            if constexpr (Stream::writing)
+            if (num_zeros == 0U)
             {
-                BS_ASSERT(previous < current);
-                difference = current - previous;
-                BS_ASSERT(difference > 0);
+                BS_ASSERT(reader.serialize_bits(difference, 1U));
             }
-
-            // +1 (1 bit)
-            bool plus_one;
-            if constexpr (Stream::writing)
-                plus_one = difference == 1;
-            BS_ASSERT(stream.template serialize<bool>(plus_one));
-            if (plus_one)
+            else if (num_zeros < 6U)
             {
-                if constexpr (Stream::reading)
-                    current = previous + 1;
-                previous = current;
-                return true;
+                BS_ASSERT(reader.serialize_bits(difference, 2U * num_zeros + 2U));
+                difference -= 2U;
+            }
+            else
+            {
+                BS_ASSERT(reader.serialize_bits(difference, 6U));
+                BS_ASSERT(reader.template serialize<int_range<uint32_t>>(int_range<uint32_t>(126U, static_cast<uint32_t>(max_size) + 1U), difference));
             }
 
-            // [+2,5] -> [0,3] (2 bits)
-            if (serialize_difference<2, 5>(stream, previous, current, difference))
-                return true;
-
-            // [6,13] -> [0,7] (3 bits)
-            if (serialize_difference<6, 13>(stream, previous, current, difference))
-                return true;
+            BS_ASSERT(difference <= static_cast<uint32_t>(max_size - previous));
 
-            // [14,29] -> [0,15] (4 bits)
-            if (serialize_difference<14, 29>(stream, previous, current, difference))
-                return true;
+            previous += static_cast<int>(difference);
 
-            // [30,61] -> [0,31] (5 bits)
-            if (serialize_difference<30, 61>(stream, previous, current, difference))
-                return true;
+            return true;
+        }
 
-            // [62,125] -> [0,63] (6 bits)
-            if (serialize_difference<62, 125>(stream, previous, current, difference))
-                return true;
+        static uint64_t get_mask_word(const uint64_t* mask, int word_index, int max_size) noexcept
+        {
+            // Ignore any bits past the end of the array
+            uint64_t word = mask[word_index];
+            int remaining = max_size - word_index * 64;
 
-            // [126,MaxObjects+1] 
-            BS_ASSERT(stream.template serialize<uint32_t>(difference, 126, max_size));
-            if constexpr (Stream::reading)
-                current = previous + difference;
-            previous = current;
-            return true;
+            return remaining < 64 ? word & ((1ULL << remaining) - 1U) : word;
         }
 
     public:
 		/**
-		 * @brief Writes a subset of the array @p values into the writer
+		 * @brief Writes a subset of the array @p values into the writer.
+		 * The indices are written either as differences or as a bit mask, depending on which is smaller
 		 * @tparam Compare A function type which returns a bool
 		 * @tparam ...Args The types of any additional arguments
 		 * @param writer The stream to write to
 		 * @param values The array of objects to serialize
 		 * @param max_size The size of the array
-		 * @param compare A function which returns true if the object should be written, false otherwise
+		 * @param compare A function which returns true if the object should be written, false otherwise. Called exactly once per object
 		 * @param ...args Any additional arguments to use when serializing each individual object
 		 * @return Success
 		*/
-        template<typename Stream, typename Compare, typename... Args>
+        template<typename Stream, typename Compare, typename... Args, typename = std::enable_if_t<std::is_invocable_v<Compare&, T&>>>
         typename utility::is_writing_t<Stream>
 		static serialize(Stream& writer, T* values, int max_size, Compare compare, Args&&... args) noexcept
 		{
-			int prev_index = -1;
-			for (int index = 0; index < max_size; index++)
-			{
-				if (!compare(values[index]))
-					continue;
+            BS_ASSERT(max_size > 0);
 
-                BS_ASSERT(serialize_index(writer, prev_index, index, max_size));
+            // Record the selection once, so that compare is only called once per object
+            constexpr int max_stack_words = 64;
+            int num_words = (max_size - 1) / 64 + 1;
 
-				BS_ASSERT(writer.template serialize<Trait>(values[index], std::forward<Args>(args)...));
-			}
+            uint64_t stack_mask[max_stack_words];
+            std::unique_ptr<uint64_t[]> heap_mask;
+            uint64_t* mask = stack_mask;
+            if (num_words > max_stack_words)
+            {
+                // Fail like any other error instead of throwing, since serialize is noexcept
+                heap_mask.reset(new (std::nothrow) uint64_t[num_words]);
+                BS_ASSERT(heap_mask);
 
-            BS_ASSERT(serialize_index(writer, prev_index, max_size, max_size));
+                mask = heap_mask.get();
+            }
+
+            for (int word_index = 0; word_index < num_words; word_index++)
+            {
+                int offset = word_index * 64;
+                int num_values = (std::min)(max_size - offset, 64);
+
+                uint64_t word = 0U;
+                for (int i = 0; i < num_values; i++)
+                    word |= static_cast<uint64_t>(static_cast<bool>(compare(values[offset + i]))) << i;
+
+                mask[word_index] = word;
+            }
+
+            return serialize(writer, values, max_size, static_cast<const uint64_t*>(mask), std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Writes a subset of the array @p values into the writer, using a precomputed mask instead of a compare function.
+		 * Only the set bits of the mask are visited, and the result is the same as using a compare function
+		 * @tparam ...Args The types of any additional arguments
+		 * @param writer The stream to write to
+		 * @param values The array of objects to serialize
+		 * @param max_size The size of the array
+		 * @param mask The objects to write, where bit i % 64 of word i / 64 is set if the object at index i should be written
+		 * @param ...args Any additional arguments to use when serializing each individual object
+		 * @return Success
+		*/
+        template<typename Stream, typename... Args>
+        typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, T* values, int max_size, const uint64_t* mask, Args&&... args) noexcept
+		{
+            BS_ASSERT(max_size > 0);
+
+            int num_words = (max_size - 1) / 64 + 1;
+
+            // Measure the differences, to see whether a bit mask would be smaller
+            uint32_t index_bits = 0U;
+            int prev_index = -1;
+            for (int word_index = 0; word_index < num_words; word_index++)
+            {
+                uint64_t word = get_mask_word(mask, word_index, max_size);
+                while (word != 0U)
+                {
+                    int index = word_index * 64 + static_cast<int>(utility::count_trailing_zeros64(word));
+                    word &= word - 1U;
+
+                    index_bits += get_index_bits(static_cast<uint32_t>(index - prev_index), max_size);
+                    prev_index = index;
+                }
+            }
+
+            index_bits += get_index_bits(static_cast<uint32_t>(max_size - prev_index), max_size);
+
+            bool use_mask = index_bits > static_cast<uint32_t>(max_size);
+            BS_ASSERT(writer.template serialize<bool>(use_mask));
+
+            if (use_mask)
+            {
+                for (int offset = 0; offset < max_size; offset += 32)
+                {
+                    uint32_t num_bits = static_cast<uint32_t>((std::min)(max_size - offset, 32));
+
+                    // The stream expects the first object in the most significant bit
+                    uint32_t chunk = static_cast<uint32_t>(get_mask_word(mask, offset / 64, max_size) >> (offset % 64));
+                    BS_ASSERT(writer.serialize_bits(utility::reverse_bits32(chunk) >> (32U - num_bits), num_bits));
+
+                    while (chunk != 0U)
+                    {
+                        int index = offset + static_cast<int>(utility::count_trailing_zeros64(chunk));
+                        chunk &= chunk - 1U;
+
+                        BS_ASSERT(writer.template serialize<Trait>(values[index], std::forward<Args>(args)...));
+                    }
+                }
+
+                return true;
+            }
+
+            prev_index = -1;
+            for (int word_index = 0; word_index < num_words; word_index++)
+            {
+                uint64_t word = get_mask_word(mask, word_index, max_size);
+                while (word != 0U)
+                {
+                    int index = word_index * 64 + static_cast<int>(utility::count_trailing_zeros64(word));
+                    word &= word - 1U;
+
+                    BS_ASSERT(write_index(writer, prev_index, index, max_size));
+
+                    BS_ASSERT(writer.template serialize<Trait>(values[index], std::forward<Args>(args)...));
+                }
+            }
+
+            BS_ASSERT(write_index(writer, prev_index, max_size, max_size));
 
 			return true;
 		}
@@ -147,11 +252,38 @@ namespace bitstream
         typename utility::is_reading_t<Stream>
 		static serialize(Stream& reader, T* values, int max_size, Args&&... args) noexcept
 		{
-			int prev_index = -1;
-            int index = 0;
+            BS_ASSERT(max_size > 0);
+
+            bool use_mask;
+            BS_ASSERT(reader.template serialize<bool>(use_mask));
+
+            if (use_mask)
+            {
+                for (int offset = 0; offset < max_size; offset += 32)
+                {
+                    uint32_t num_bits = static_cast<uint32_t>((std::min)(max_size - offset, 32));
+
+                    uint32_t mask;
+                    BS_ASSERT(reader.serialize_bits(mask, num_bits));
+
+                    // Skip straight to each set bit
+                    uint64_t remaining = static_cast<uint64_t>(mask) << (64U - num_bits);
+                    while (remaining != 0U)
+                    {
+                        uint32_t i = utility::count_leading_zeros64(remaining);
+                        remaining &= ~(1ULL << (63U - i));
+
+                        BS_ASSERT(reader.template serialize<Trait>(values[offset + i], std::forward<Args>(args)...));
+                    }
+                }
+
+                return true;
+            }
+
+			int index = -1;
 			while (true)
 			{
-                BS_ASSERT(serialize_index(reader, prev_index, index, max_size));
+                BS_ASSERT(read_index(reader, index, max_size));
 
 				if (index == max_size)
 					break;
@@ -162,4 +294,252 @@ namespace bitstream
 			return true;
 		}
 	};
+
+	/**
+	 * @brief Wrapper type for arrays of integers packed relative to a per-block minimum
+	 * @tparam T The type of the integers in the array
+	 * @tparam BlockSize The number of integers in each block
+	*/
+	template<typename T, uint32_t BlockSize = 128U>
+	struct for_packed;
+
+	/**
+	 * @brief A trait used for serializing arrays of integers using patched frame-of-reference packing.
+	 * Each block stores its minimum and a bit width, after which the offsets from the minimum are packed using that bit width.
+	 * Offsets which don't fit in the bit width are patched afterwards from a list of exceptions.
+	 * @tparam T The type of the integers in the array
+	 * @tparam BlockSize The number of integers in each block
+	*/
+	template<typename T, uint32_t BlockSize>
+	struct serialize_traits<for_packed<T, BlockSize>, typename std::enable_if_t<std::is_integral_v<T> && !std::is_const_v<T>>>
+	{
+		static_assert(BlockSize > 0U, "The block size must be at least 1");
+		static_assert(sizeof(T) <= 8, "Integers larger than 8 bytes are currently not supported");
+
+    private:
+        using unsigned_type = std::make_unsigned_t<T>;
+
+        static constexpr uint32_t type_bits = sizeof(T) * 8U;
+        static constexpr uint32_t width_bits = utility::bits_to_represent(type_bits);
+        static constexpr uint32_t index_bits = BlockSize > 1U ? utility::bits_to_represent(BlockSize - 1U) : 1U;
+        static constexpr uint32_t count_bits = utility::bits_to_represent(BlockSize);
+
+        static constexpr uint64_t low_mask(uint32_t num_bits) noexcept
+        {
+            return num_bits >= 64U ? ~0ULL : ((1ULL << num_bits) - 1ULL);
+        }
+
+        template<typename Stream>
+        typename utility::is_writing_t<Stream>
+        static serialize_offset(Stream& writer, uint64_t value, uint32_t num_bits) noexcept
+        {
+            if (num_bits > 32U)
+            {
+                // If the offset is bigger than a word (32 bits)
+                BS_ASSERT(writer.serialize_bits(static_cast<uint32_t>(value), 32U));
+
+                return writer.serialize_bits(static_cast<uint32_t>(value >> 32U), num_bits - 32U);
+            }
+
+            return writer.serialize_bits(static_cast<uint32_t>(value), num_bits);
+        }
+
+        template<typename Stream>
+        typename utility::is_reading_t<Stream>
+        static serialize_offset(Stream& reader, uint64_t& value, uint32_t num_bits) noexcept
+        {
+            uint32_t unsigned_value;
+            if (num_bits > 32U)
+            {
+                // If the offset is bigger than a word (32 bits)
+                BS_ASSERT(reader.serialize_bits(unsigned_value, 32U));
+                value = unsigned_value;
+
+                BS_ASSERT(reader.serialize_bits(unsigned_value, num_bits - 32U));
+                value |= static_cast<uint64_t>(unsigned_value) << 32U;
+
+                return true;
+            }
+
+            BS_ASSERT(reader.serialize_bits(unsigned_value, num_bits));
+            value = unsigned_value;
+
+            return true;
+        }
+
+        template<typename Stream>
+        typename utility::is_writing_t<Stream>
+        static serialize_block(Stream& writer, const T* values, uint32_t count) noexcept
+        {
+            T min = values[0];
+            for (uint32_t i = 1U; i < count; i++)
+                min = values[i] < min ? values[i] : min;
+
+            // Count how many offsets require each bit width
+            uint32_t histogram[type_bits + 1U]{};
+            uint32_t max_width = 0U;
+            for (uint32_t i = 0U; i < count; i++)
+            {
+                uint64_t offset = static_cast<unsigned_type>(static_cast<unsigned_type>(values[i]) - static_cast<unsigned_type>(min));
+                uint32_t width = utility::bits_to_represent(offset);
+                histogram[width]++;
+                max_width = width > max_width ? width : max_width;
+            }
+
+            // Find the bit width which results in the fewest bits, including exceptions
+            uint32_t bit_width = max_width;
+            uint64_t best_cost = static_cast<uint64_t>(count) * max_width;
+            uint32_t num_exceptions = 0U;
+            for (uint32_t width = max_width; width-- > 0U;)
+            {
+                num_exceptions += histogram[width + 1U];
+
+                uint64_t cost = static_cast<uint64_t>(count) * width + count_bits + static_cast<uint64_t>(num_exceptions) * (index_bits + max_width - width);
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    bit_width = width;
+                }
+            }
+
+            uint32_t exception_width = max_width - bit_width;
+
+            unsigned_type base = static_cast<unsigned_type>(min);
+
+            BS_ASSERT(writer.template serialize<bounded_int<unsigned_type>>(base));
+            BS_ASSERT(writer.serialize_bits(bit_width, width_bits));
+            BS_ASSERT(writer.serialize_bits(exception_width, width_bits));
+
+            // Pack the lower bits of every offset
+            if (bit_width > 0U)
+            {
+                for (uint32_t i = 0U; i < count; i++)
+                {
+                    uint64_t offset = static_cast<unsigned_type>(static_cast<unsigned_type>(values[i]) - static_cast<unsigned_type>(min));
+                    BS_ASSERT(serialize_offset(writer, offset & low_mask(bit_width), bit_width));
+                }
+            }
+
+            if (exception_width == 0U)
+                return true;
+
+            // Patch the upper bits of offsets which didn't fit
+            uint32_t exception_count = 0U;
+            for (uint32_t width = bit_width + 1U; width <= max_width; width++)
+                exception_count += histogram[width];
+
+            BS_ASSERT(writer.serialize_bits(exception_count, count_bits));
+
+            for (uint32_t i = 0U; i < count; i++)
+            {
+                uint64_t offset = static_cast<unsigned_type>(static_cast<unsigned_type>(values[i]) - static_cast<unsigned_type>(min));
+                if ((offset >> bit_width) == 0U)
+                    continue;
+
+                BS_ASSERT(writer.serialize_bits(i, index_bits));
+                BS_ASSERT(serialize_offset(writer, offset >> bit_width, exception_width));
+            }
+
+            return true;
+        }
+
+        template<typename Stream>
+        typename utility::is_reading_t<Stream>
+        static serialize_block(Stream& reader, T* values, uint32_t count) noexcept
+        {
+            unsigned_type base;
+            uint32_t bit_width;
+            uint32_t exception_width;
+
+            BS_ASSERT(reader.template serialize<bounded_int<unsigned_type>>(base));
+            BS_ASSERT(reader.serialize_bits(bit_width, width_bits));
+            BS_ASSERT(reader.serialize_bits(exception_width, width_bits));
+
+            BS_ASSERT(bit_width <= type_bits && exception_width <= type_bits - bit_width);
+
+            // Unpack the lower bits of every offset
+            if (bit_width > 0U)
+            {
+                for (uint32_t i = 0U; i < count; i++)
+                {
+                    uint64_t offset;
+                    BS_ASSERT(serialize_offset(reader, offset, bit_width));
+
+                    values[i] = static_cast<T>(static_cast<unsigned_type>(base + static_cast<unsigned_type>(offset)));
+                }
+            }
+            else
+            {
+                for (uint32_t i = 0U; i < count; i++)
+                    values[i] = static_cast<T>(base);
+            }
+
+            if (exception_width == 0U)
+                return true;
+
+            // Patch the upper bits of offsets which didn't fit
+            uint32_t exception_count;
+            BS_ASSERT(reader.serialize_bits(exception_count, count_bits));
+
+            BS_ASSERT(exception_count > 0U && exception_count <= count);
+
+            for (uint32_t i = 0U; i < exception_count; i++)
+            {
+                uint32_t index;
+                BS_ASSERT(reader.serialize_bits(index, index_bits));
+
+                BS_ASSERT(index < count);
+
+                uint64_t high_bits;
+                BS_ASSERT(serialize_offset(reader, high_bits, exception_width));
+
+                values[index] = static_cast<T>(static_cast<unsigned_type>(static_cast<unsigned_type>(values[index]) + static_cast<unsigned_type>(high_bits << bit_width)));
+            }
+
+            return true;
+        }
+
+    public:
+		/**
+		 * @brief Writes an array of integers into the writer
+		 * @param writer The stream to write to
+		 * @param values The array of integers to serialize
+		 * @param size The number of integers in the array
+		 * @return Success
+		*/
+        template<typename Stream>
+        typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const T* values, uint32_t size) noexcept
+		{
+			for (uint32_t offset = 0U; offset < size; offset += BlockSize)
+			{
+				uint32_t count = (std::min)(BlockSize, size - offset);
+
+				BS_ASSERT(serialize_block(writer, values + offset, count));
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads an array of integers into @p values
+		 * @param reader The stream to read from
+		 * @param values The array of integers to read into
+		 * @param size The number of integers in the array
+		 * @return Success
+		*/
+        template<typename Stream>
+        typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, T* values, uint32_t size) noexcept
+		{
+			for (uint32_t offset = 0U; offset < size; offset += BlockSize)
+			{
+				uint32_t count = (std::min)(BlockSize, size - offset);
+
+				BS_ASSERT(serialize_block(reader, values + offset, count));
+			}
+
+			return true;
+		}
+	};
 }
\ No newline at end of file
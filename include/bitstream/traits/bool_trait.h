@@ -1,10 +1,18 @@
 #pragma once
 #include "../utility/assert.h"
+#include "../utility/bitmask.h"
+#include "../utility/bits.h"
 #include "../utility/meta.h"
 #include "../utility/parameter.h"
 
 #include "../stream/serialize_traits.h"
 
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace bitstream
 {
 	/**
@@ -37,7 +45,7 @@ namespace bitstream
 	};
 
 	/**
-	 * @brief A trait used to serialize multiple boolean values
+	 * @brief A trait used to serialize multiple boolean values, packed 64 at a time
 	*/
 	template<size_t Size>
 	struct serialize_traits<bool[Size]>
@@ -46,26 +54,150 @@ namespace bitstream
 		typename utility::is_writing_t<Stream>
 		static serialize(Stream& writer, const bool* values) noexcept
 		{
-			uint32_t unsigned_value;
-			for (size_t i = 0; i < Size; i++)
+			for (size_t offset = 0U; offset < Size; offset += 64U)
 			{
-				unsigned_value = values[i];
-				BS_ASSERT(writer.serialize_bits(unsigned_value, 1U));
+				uint32_t num_bits = static_cast<uint32_t>((std::min)(Size - offset, size_t(64U)));
+
+				uint64_t word;
+				utility::pack_flags(values + offset, num_bits, &word);
+
+				// The first bool is written first, so it needs to be in the most significant bit
+				BS_ASSERT(writer.serialize_bits(utility::reverse_bits64(word) >> (64U - num_bits), num_bits));
 			}
 
-			return writer.serialize_bits(unsigned_value, 1U);
+			return true;
 		}
 
 		template<typename Stream>
 		typename utility::is_reading_t<Stream>
 		static serialize(Stream& reader, bool* values) noexcept
 		{
-			uint32_t unsigned_value;
-			for (size_t i = 0; i < Size; i++)
+			for (size_t offset = 0U; offset < Size; offset += 64U)
+			{
+				uint32_t num_bits = static_cast<uint32_t>((std::min)(Size - offset, size_t(64U)));
+
+				uint64_t word;
+				BS_ASSERT(reader.serialize_bits(word, num_bits));
+
+				word = utility::reverse_bits64(word << (64U - num_bits));
+				utility::unpack_flags(&word, num_bits, values + offset);
+			}
+
+			return true;
+		}
+	};
+
+	/**
+	 * @brief A trait used to serialize a bitset, 64 bits at a time
+	*/
+	template<size_t Size>
+	struct serialize_traits<std::bitset<Size>>
+	{
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const std::bitset<Size>& values) noexcept
+		{
+			for (size_t offset = 0U; offset < Size; offset += 64U)
+			{
+				uint32_t num_bits = static_cast<uint32_t>((std::min)(Size - offset, size_t(64U)));
+
+				// The standard doesn't expose the underlying words, so gather them instead
+				uint64_t word = 0U;
+				for (uint32_t i = 0U; i < num_bits; i++)
+					word |= static_cast<uint64_t>(values[offset + i]) << (num_bits - 1U - i);
+
+				BS_ASSERT(writer.serialize_bits(word, num_bits));
+			}
+
+			return true;
+		}
+
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, std::bitset<Size>& values) noexcept
+		{
+			for (size_t offset = 0U; offset < Size; offset += 64U)
 			{
-				BS_ASSERT(reader.serialize_bits(unsigned_value, 1U));
+				uint32_t num_bits = static_cast<uint32_t>((std::min)(Size - offset, size_t(64U)));
+
+				uint64_t word;
+				BS_ASSERT(reader.serialize_bits(word, num_bits));
+
+				for (uint32_t i = 0U; i < num_bits; i++)
+					values[offset + i] = (word >> (num_bits - 1U - i)) & 1U;
+			}
+
+			return true;
+		}
+	};
+
+	/**
+	 * @brief A trait used to serialize a vector of booleans, 64 bits at a time, prefixed by its size
+	*/
+	template<typename Allocator>
+	struct serialize_traits<std::vector<bool, Allocator>>
+	{
+		/**
+		 * @brief Writes a vector of booleans into the @p writer
+		 * @param writer The stream to write to
+		 * @param values The booleans to write
+		 * @param max_size The maximum expected size of the vector
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const std::vector<bool, Allocator>& values, uint32_t max_size) noexcept
+		{
+			BS_ASSERT(values.size() <= max_size);
+
+			uint32_t size = static_cast<uint32_t>(values.size());
+			uint32_t num_bits = utility::bits_to_represent(max_size);
+
+			BS_ASSERT(writer.serialize_bits(size, num_bits));
+
+			for (uint32_t offset = 0U; offset < size; offset += 64U)
+			{
+				uint32_t num_word_bits = (std::min)(size - offset, 64U);
+
+				uint64_t word = 0U;
+				for (uint32_t i = 0U; i < num_word_bits; i++)
+					word |= static_cast<uint64_t>(values[offset + i]) << (num_word_bits - 1U - i);
+
+				BS_ASSERT(writer.serialize_bits(word, num_word_bits));
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads a vector of booleans from the @p reader
+		 * @param reader The stream to read from
+		 * @param values The vector to read into. Will be resized to the serialized size
+		 * @param max_size The maximum expected size of the vector
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, std::vector<bool, Allocator>& values, uint32_t max_size)
+		{
+			uint32_t num_bits = utility::bits_to_represent(max_size);
+
+			uint32_t size;
+			BS_ASSERT(reader.serialize_bits(size, num_bits));
+
+			BS_ASSERT(size <= max_size);
+
+			values.resize(size);
+
+			for (uint32_t offset = 0U; offset < size; offset += 64U)
+			{
+				uint32_t num_word_bits = (std::min)(size - offset, 64U);
+
+				uint64_t word;
+				BS_ASSERT(reader.serialize_bits(word, num_word_bits));
 
-				values[i] = unsigned_value;
+				for (uint32_t i = 0U; i < num_word_bits; i++)
+					values[offset + i] = (word >> (num_word_bits - 1U - i)) & 1U;
 			}
 
 			return true;
@@ -0,0 +1,176 @@
+#pragma once
+#include "../utility/assert.h"
+#include "../utility/endian.h"
+#include "../utility/meta.h"
+
+#include "../stream/bit_writer.h"
+#include "../stream/serialize_traits.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bitstream
+{
+	/**
+	 * @brief Wrapper type for objects which rarely change, whose serialized bits are cached after the first write
+	 * @tparam Trait The trait used to serialize the objects the first time
+	*/
+	template<typename Trait>
+	struct cached;
+
+	/**
+	 * @brief A cache of serialized bits, keyed by object identity and a version counter.
+	 * Entries are replaced when written with a different version, and can be invalidated manually when an object changes or is destroyed.
+	 * The memory of replaced entries is reused
+	*/
+	class serialize_cache
+	{
+	public:
+		/**
+		 * @brief The bits produced by serializing an object
+		*/
+		struct entry
+		{
+			uint32_t version = 0U;
+			uint32_t num_bits = 0U;
+			bool valid = false;
+			std::vector<uint32_t> words;
+		};
+
+		/**
+		 * @brief Returns the cached bits of the object with the given @p key
+		 * @param key The identity of the object
+		 * @param version The version of the object
+		 * @return The entry, or nullptr if the object has not been cached with this @p version
+		*/
+		const entry* find(const void* key, uint32_t version) const noexcept
+		{
+			auto iter = m_Entries.find(key);
+			if (iter == m_Entries.end() || !iter->second.valid || iter->second.version != version)
+				return nullptr;
+
+			return &iter->second;
+		}
+
+		/**
+		 * @brief Returns the entry to store the bits of the object with the given @p key into, replacing any previous version
+		 * @param key The identity of the object
+		 * @param version The version of the object
+		 * @return The entry, which is not valid until the bits have been stored
+		*/
+		entry& store(const void* key, uint32_t version)
+		{
+			entry& cached_entry = m_Entries[key];
+			cached_entry.version = version;
+			cached_entry.num_bits = 0U;
+			cached_entry.valid = false;
+
+			return cached_entry;
+		}
+
+		/**
+		 * @brief Invalidates the cached bits of the object with the given @p key, so it is serialized again on the next write
+		 * @param key The identity of the object
+		*/
+		void invalidate(const void* key) noexcept
+		{
+			auto iter = m_Entries.find(key);
+			if (iter != m_Entries.end())
+				iter->second.valid = false;
+		}
+
+		/**
+		 * @brief Removes the object with the given @p key from the cache, like when the object is destroyed
+		 * @param key The identity of the object
+		*/
+		void erase(const void* key) noexcept
+		{
+			m_Entries.erase(key);
+		}
+
+		/**
+		 * @brief Removes every object from the cache
+		*/
+		void clear() noexcept
+		{
+			m_Entries.clear();
+		}
+
+		size_t size() const noexcept { return m_Entries.size(); }
+
+	private:
+		std::unordered_map<const void*, entry> m_Entries;
+	};
+
+	/**
+	 * @brief A trait used to serialize an object once with @p Trait, and afterwards copy the cached bits into the stream a word at a time.
+	 * Reading is the same as reading with @p Trait
+	 * @tparam Trait The trait used to serialize the objects
+	*/
+	template<typename Trait>
+	struct serialize_traits<cached<Trait>>
+	{
+		/**
+		 * @brief Writes an object into the @p writer, using the cached bits if the object has been written before with the same @p version
+		 * @param writer The stream to write to
+		 * @param cache The cache to look up and store the bits in
+		 * @param key The identity of the object, usually its address
+		 * @param version The version of the object, which should be changed whenever the object changes
+		 * @param ...args The arguments to pass to @p Trait
+		 * @return Success
+		*/
+		template<typename Stream, typename... Args>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, serialize_cache& cache, const void* key, uint32_t version, Args&&... args)
+		{
+			const serialize_cache::entry* cached_entry = cache.find(key, version);
+			if (!cached_entry)
+			{
+				serialize_cache::entry& new_entry = cache.store(key, version);
+
+				growing_bit_writer<std::vector<uint32_t>> cache_writer(new_entry.words);
+
+				BS_ASSERT(cache_writer.template serialize<Trait>(std::forward<Args>(args)...));
+
+				new_entry.num_bits = cache_writer.flush();
+				new_entry.valid = true;
+
+				cached_entry = &new_entry;
+			}
+
+			uint32_t num_words = cached_entry->num_bits / 32U;
+			uint32_t remainder_bits = cached_entry->num_bits % 32U;
+
+			BS_ASSERT(writer.can_serialize_bits(cached_entry->num_bits));
+
+			BS_ASSERT(writer.serialize_words(cached_entry->words.data(), num_words));
+
+			if (remainder_bits > 0U)
+			{
+				uint32_t value = utility::to_big_endian32(cached_entry->words[num_words]) >> (32U - remainder_bits);
+
+				BS_ASSERT(writer.serialize_bits(value, remainder_bits));
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads an object from the @p reader. The cache is not used when reading
+		 * @param reader The stream to read from
+		 * @param cache Unused
+		 * @param key Unused
+		 * @param version Unused
+		 * @param ...args The arguments to pass to @p Trait
+		 * @return Success
+		*/
+		template<typename Stream, typename... Args>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, serialize_cache& /*cache*/, const void* /*key*/, uint32_t /*version*/, Args&&... args)
+		{
+			return reader.template serialize<Trait>(std::forward<Args>(args)...);
+		}
+	};
+}
\ No newline at end of file
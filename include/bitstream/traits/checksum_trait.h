@@ -55,6 +55,8 @@ namespace bitstream
 		typename utility::is_reading_t<Stream>
 		static serialize(Stream& reader) noexcept
 		{
+			static_assert(utility::has_buffer_v<Stream>, "A checksum is generated from the reader's whole buffer, so it can't be read from a segmented_bit_reader");
+
 			if (reader.get_num_bits_serialized() > 0)
 				return true;
 			
@@ -0,0 +1,500 @@
+#pragma once
+#include "../quantization/bounded_range.h"
+#include "../quantization/smallest_three.h"
+#include "../utility/assert.h"
+#include "../utility/meta.h"
+#include "../utility/parameter.h"
+
+#include "../stream/serialize_traits.h"
+
+#include "../traits/integral_traits.h"
+#include "../traits/predicted_traits.h"
+#include "../traits/quantization_traits.h"
+#include "../traits/string_traits.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace bitstream
+{
+	/**
+	 * @brief Wrapper type for values serialized against a baseline that the reader has acknowledged
+	 * @tparam Trait The trait used to serialize the values when they differ from the baseline
+	*/
+	template<typename Trait>
+	struct delta;
+
+	/**
+	 * @brief A trait used to serialize a value as a single bit if it matches the baseline, or using @p Trait otherwise.
+	 * The value is compared to the baseline with operator==, and must be the first argument of @p Trait, followed by any other arguments.
+	 * The type of the baseline is taken from the value.
+	 * If serialize_traits<Trait> has a serialize_delta function taking the same arguments as this trait, it is used instead of @p Trait when the values differ.
+	 * This allows aggregates to serialize each of their fields as a delta as well
+	 * @tparam Trait The trait used to serialize the values
+	*/
+	template<typename Trait>
+	struct serialize_traits<delta<Trait>>
+	{
+		/**
+		 * @brief Writes a value as a delta against the @p baseline into the @p writer
+		 * @param writer The stream to write to
+		 * @param current The value to serialize
+		 * @param baseline The value that the reader already has
+		 * @param ...args The rest of the arguments to pass to @p Trait
+		 * @return Success
+		*/
+		template<typename Stream, typename T, typename... Args>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const T& current, const std::decay_t<T>& baseline, Args&&... args)
+		{
+			// Integers are written as a residual against the baseline, like the bounded traits
+			if constexpr (utility::is_integral_v<Trait> && sizeof...(Args) == 0)
+				return serialize_traits<delta<bounded_int<Trait>>>::serialize(writer, current, baseline);
+			else if constexpr (utility::is_integral_v<Trait>)
+				return serialize_traits<delta<int_range<Trait>>>::serialize(writer, int_range<Trait>(std::forward<Args>(args)...), current, baseline);
+			else
+			{
+				bool changed = !(current == baseline);
+
+				BS_ASSERT(writer.serialize_bits(static_cast<uint32_t>(changed), 1U));
+
+				if (!changed)
+					return true;
+
+				if constexpr (utility::has_serialize_delta_v<Trait, Stream, const T&, const T&, Args...>)
+					return serialize_traits<Trait>::serialize_delta(writer, current, baseline, std::forward<Args>(args)...);
+				else
+					return writer.template serialize<Trait>(current, std::forward<Args>(args)...);
+			}
+		}
+
+		/**
+		 * @brief Reads a value as a delta against the @p baseline from the @p reader
+		 * @param reader The stream to read from
+		 * @param value The value to read into
+		 * @param baseline The value that was acknowledged by this side
+		 * @param ...args The rest of the arguments to pass to @p Trait
+		 * @return Success
+		*/
+		template<typename Stream, typename T, typename... Args>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, T& value, const std::decay_t<T>& baseline, Args&&... args)
+		{
+			if constexpr (utility::is_integral_v<Trait> && sizeof...(Args) == 0)
+				return serialize_traits<delta<bounded_int<Trait>>>::serialize(reader, value, baseline);
+			else if constexpr (utility::is_integral_v<Trait>)
+				return serialize_traits<delta<int_range<Trait>>>::serialize(reader, int_range<Trait>(std::forward<Args>(args)...), value, baseline);
+			else
+			{
+				uint32_t changed;
+				BS_ASSERT(reader.serialize_bits(changed, 1U));
+
+				if (!changed)
+				{
+					value = baseline;
+					return true;
+				}
+
+				if constexpr (utility::has_serialize_delta_v<Trait, Stream, T&, const T&, Args...>)
+					return serialize_traits<Trait>::serialize_delta(reader, value, baseline, std::forward<Args>(args)...);
+				else
+					return reader.template serialize<Trait>(value, std::forward<Args>(args)...);
+			}
+		}
+	};
+
+	/**
+	 * @brief A trait used to serialize an integer within a precomputed runtime range as a delta.
+	 * Changed values are written as a residual against the baseline, if the range fits in 32 bits
+	 * @tparam T A type matching an integer value
+	*/
+	template<typename T>
+	struct serialize_traits<delta<int_range<T>>>
+	{
+		using unsigned_type = utility::make_unsigned_t<T>;
+
+		/**
+		 * @brief Writes an integer as a delta against the @p baseline into the @p writer
+		 * @param writer The stream to write to
+		 * @param range The range that the values are within
+		 * @param current The value to serialize
+		 * @param baseline The value that the reader already has
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, in<int_range<T>> range, in<T> current, in<T> baseline) noexcept
+		{
+			bool changed = current != baseline;
+
+			BS_ASSERT(writer.serialize_bits(static_cast<uint32_t>(changed), 1U));
+
+			if (!changed)
+				return true;
+
+			uint32_t num_bits = range.get_bits_required();
+			if (num_bits > 32U)
+				return writer.template serialize<int_range<T>>(range, current);
+
+			BS_ASSERT(current >= range.get_min() && current <= range.get_max());
+			BS_ASSERT(baseline >= range.get_min() && baseline <= range.get_max());
+
+			return writer.template serialize<predicted<uint32_t>>(get_offset(range, current), get_offset(range, baseline), num_bits);
+		}
+
+		/**
+		 * @brief Reads an integer as a delta against the @p baseline from the @p reader
+		 * @param reader The stream to read from
+		 * @param range The range that the values are within
+		 * @param value The value to read into
+		 * @param baseline The value that was acknowledged by this side
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, in<int_range<T>> range, T& value, in<T> baseline) noexcept
+		{
+			uint32_t changed;
+			BS_ASSERT(reader.serialize_bits(changed, 1U));
+
+			if (!changed)
+			{
+				value = baseline;
+				return true;
+			}
+
+			uint32_t num_bits = range.get_bits_required();
+			if (num_bits > 32U)
+				return reader.template serialize<int_range<T>>(range, value);
+
+			BS_ASSERT(baseline >= range.get_min() && baseline <= range.get_max());
+
+			uint32_t offset;
+			BS_ASSERT(reader.template serialize<predicted<uint32_t>>(offset, get_offset(range, baseline), num_bits));
+
+			BS_ASSERT(offset <= get_offset(range, range.get_max()));
+
+			value = static_cast<T>(static_cast<unsigned_type>(static_cast<unsigned_type>(range.get_min()) + offset));
+
+			return true;
+		}
+
+	private:
+		static constexpr uint32_t get_offset(in<int_range<T>> range, in<T> value) noexcept
+		{
+			return static_cast<uint32_t>(static_cast<unsigned_type>(value) - static_cast<unsigned_type>(range.get_min()));
+		}
+	};
+
+	/**
+	 * @brief A trait used to serialize an integer with compiletime bounds as a delta
+	 * @tparam T A type matching an integer value
+	 * @tparam Min The lower bound. Inclusive
+	 * @tparam Max The upper bound. Inclusive
+	*/
+	template<typename T, T Min, T Max>
+	struct serialize_traits<delta<bounded_int<T, Min, Max>>>
+	{
+		static constexpr int_range<T> range = int_range<T>(Min, Max);
+
+		/**
+		 * @brief Writes an integer as a delta against the @p baseline into the @p writer
+		 * @param writer The stream to write to
+		 * @param current The value to serialize
+		 * @param baseline The value that the reader already has
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, in<T> current, in<T> baseline) noexcept
+		{
+			return serialize_traits<delta<int_range<T>>>::serialize(writer, range, current, baseline);
+		}
+
+		/**
+		 * @brief Reads an integer as a delta against the @p baseline from the @p reader
+		 * @param reader The stream to read from
+		 * @param value The value to read into
+		 * @param baseline The value that was acknowledged by this side
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, T& value, in<T> baseline) noexcept
+		{
+			return serialize_traits<delta<int_range<T>>>::serialize(reader, range, value, baseline);
+		}
+	};
+
+	/**
+	 * @brief A trait used to serialize a bounded float as a delta.
+	 * The values are compared after quantization, and changed values are written as a residual against the baseline
+	*/
+	template<>
+	struct serialize_traits<delta<bounded_range>>
+	{
+		/**
+		 * @brief Writes a float as a delta against the @p baseline into the @p writer
+		 * @param writer The stream to write to
+		 * @param range The range and precision of the float
+		 * @param current The float to serialize
+		 * @param baseline The float that the reader already has
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, in<bounded_range> range, in<float> current, in<float> baseline) noexcept
+		{
+			uint32_t quantized = range.quantize(current);
+			uint32_t quantized_baseline = range.quantize(baseline);
+
+			bool changed = quantized != quantized_baseline;
+
+			BS_ASSERT(writer.serialize_bits(static_cast<uint32_t>(changed), 1U));
+
+			if (!changed)
+				return true;
+
+			return writer.template serialize<predicted<uint32_t>>(quantized, quantized_baseline, range.get_bits_required());
+		}
+
+		/**
+		 * @brief Reads a float as a delta against the @p baseline from the @p reader
+		 * @param reader The stream to read from
+		 * @param range The range and precision of the float
+		 * @param value The float to read into
+		 * @param baseline The float that was acknowledged by this side
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, in<bounded_range> range, float& value, in<float> baseline) noexcept
+		{
+			uint32_t changed;
+			BS_ASSERT(reader.serialize_bits(changed, 1U));
+
+			if (!changed)
+			{
+				value = baseline;
+				return true;
+			}
+
+			uint32_t quantized;
+			BS_ASSERT(reader.template serialize<predicted<uint32_t>>(quantized, range.quantize(baseline), range.get_bits_required()));
+
+			value = range.dequantize(quantized);
+
+			return true;
+		}
+	};
+
+	/**
+	 * @brief A trait used to serialize a 3D vector as a delta, with a bounded_range per axis.
+	 * The vectors are compared after quantization, and changed vectors are written as residuals against the baseline
+	*/
+	template<typename V>
+	struct serialize_traits<delta<bounded_vector3<V>>>
+	{
+		/**
+		 * @brief Writes a vector as a delta against the @p baseline into the @p writer
+		 * @param writer The stream to write to
+		 * @param ranges The range and precision of each axis
+		 * @param current The vector to serialize
+		 * @param baseline The vector that the reader already has
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const bounded_range (&ranges)[3], in<V> current, in<V> baseline) noexcept
+		{
+			bool changed = false;
+			for (uint32_t i = 0U; i < 3U; i++)
+				changed |= ranges[i].quantize(current[i]) != ranges[i].quantize(baseline[i]);
+
+			BS_ASSERT(writer.serialize_bits(static_cast<uint32_t>(changed), 1U));
+
+			if (!changed)
+				return true;
+
+			return writer.template serialize<predicted<bounded_vector3<V>>>(ranges, current, baseline);
+		}
+
+		/**
+		 * @brief Reads a vector as a delta against the @p baseline from the @p reader
+		 * @param reader The stream to read from
+		 * @param ranges The range and precision of each axis
+		 * @param value The vector to read into
+		 * @param baseline The vector that was acknowledged by this side
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, const bounded_range (&ranges)[3], V& value, in<V> baseline) noexcept
+		{
+			uint32_t changed;
+			BS_ASSERT(reader.serialize_bits(changed, 1U));
+
+			if (!changed)
+			{
+				value = baseline;
+				return true;
+			}
+
+			return reader.template serialize<predicted<bounded_vector3<V>>>(ranges, value, baseline);
+		}
+	};
+
+	/**
+	 * @brief A trait used to serialize a quaternion as a delta.
+	 * The quaternions are compared after quantization, and changed quaternions are written as residuals against the baseline
+	*/
+	template<typename Q, size_t BitsPerElement>
+	struct serialize_traits<delta<smallest_three<Q, BitsPerElement>>>
+	{
+		/**
+		 * @brief Writes a quaternion as a delta against the @p baseline into the @p writer
+		 * @param writer The stream to write to
+		 * @param current The quaternion to serialize
+		 * @param baseline The quaternion that the reader already has
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, in<Q> current, in<Q> baseline) noexcept
+		{
+			quantized_quaternion quantized = smallest_three<Q, BitsPerElement>::quantize(current);
+			quantized_quaternion quantized_baseline = smallest_three<Q, BitsPerElement>::quantize(baseline);
+
+			bool changed = quantized.m != quantized_baseline.m ||
+				quantized.a != quantized_baseline.a ||
+				quantized.b != quantized_baseline.b ||
+				quantized.c != quantized_baseline.c;
+
+			BS_ASSERT(writer.serialize_bits(static_cast<uint32_t>(changed), 1U));
+
+			if (!changed)
+				return true;
+
+			return writer.template serialize<predicted<smallest_three<Q, BitsPerElement>>>(current, baseline);
+		}
+
+		/**
+		 * @brief Reads a quaternion as a delta against the @p baseline from the @p reader
+		 * @param reader The stream to read from
+		 * @param value The quaternion to read into
+		 * @param baseline The quaternion that was acknowledged by this side
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, Q& value, in<Q> baseline) noexcept
+		{
+			uint32_t changed;
+			BS_ASSERT(reader.serialize_bits(changed, 1U));
+
+			if (!changed)
+			{
+				value = baseline;
+				return true;
+			}
+
+			return reader.template serialize<predicted<smallest_three<Q, BitsPerElement>>>(value, baseline);
+		}
+	};
+
+	/**
+	 * @brief A trait used to serialize a c-style string as a delta.
+	 * The strings are compared by their contents, and changed strings are written in full
+	*/
+	template<>
+	struct serialize_traits<delta<const char*>>
+	{
+		/**
+		 * @brief Writes a c-style string as a delta against the @p baseline into the @p writer
+		 * @param writer The stream to write to
+		 * @param current The string to serialize
+		 * @param baseline The string that the reader already has
+		 * @param max_size The maximum expected length of the strings, including the null terminator
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const char* current, const char* baseline, uint32_t max_size) noexcept
+		{
+			bool changed = std::strcmp(current, baseline) != 0;
+
+			BS_ASSERT(writer.serialize_bits(static_cast<uint32_t>(changed), 1U));
+
+			if (!changed)
+				return true;
+
+			return writer.template serialize<const char*>(current, max_size);
+		}
+
+		/**
+		 * @brief Reads a c-style string as a delta against the @p baseline from the @p reader
+		 * @param reader The stream to read from
+		 * @param value A pointer to the buffer that should be read into. The size of this buffer should be at least @p max_size
+		 * @param baseline The string that was acknowledged by this side
+		 * @param max_size The maximum expected length of the strings, including the null terminator
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, char* value, const char* baseline, uint32_t max_size) noexcept
+		{
+			uint32_t changed;
+			BS_ASSERT(reader.serialize_bits(changed, 1U));
+
+			if (changed)
+				return reader.template serialize<const char*>(value, max_size);
+
+			uint32_t length = static_cast<uint32_t>(std::char_traits<char>::length(baseline));
+
+			BS_ASSERT(length < max_size);
+
+			std::memcpy(value, baseline, length + 1U);
+
+			return true;
+		}
+	};
+
+	/**
+	 * @brief A trait used to serialize a c-style string with compiletime bounds as a delta
+	 * @tparam MaxSize The maximum expected length of the string, including the null terminator
+	*/
+	template<size_t MaxSize>
+	struct serialize_traits<delta<bounded_string<const char*, MaxSize>>>
+	{
+		/**
+		 * @brief Writes a c-style string as a delta against the @p baseline into the @p writer
+		 * @param writer The stream to write to
+		 * @param current The string to serialize
+		 * @param baseline The string that the reader already has
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const char* current, const char* baseline) noexcept
+		{
+			return serialize_traits<delta<const char*>>::serialize(writer, current, baseline, static_cast<uint32_t>(MaxSize));
+		}
+
+		/**
+		 * @brief Reads a c-style string as a delta against the @p baseline from the @p reader
+		 * @param reader The stream to read from
+		 * @param value A pointer to the buffer that should be read into. The size of this buffer should be at least @p MaxSize
+		 * @param baseline The string that was acknowledged by this side
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, char* value, const char* baseline) noexcept
+		{
+			return serialize_traits<delta<const char*>>::serialize(reader, value, baseline, static_cast<uint32_t>(MaxSize));
+		}
+	};
+}
\ No newline at end of file
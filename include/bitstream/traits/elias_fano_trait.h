@@ -0,0 +1,460 @@
+#pragma once
+#include "../utility/assert.h"
+#include "../utility/bits.h"
+#include "../utility/meta.h"
+#include "../utility/parameter.h"
+
+#include "../stream/serialize_traits.h"
+
+#include "../traits/integral_traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace bitstream
+{
+	/**
+	 * @brief Wrapper type for monotone sequences of unsigned integers, like sorted sets of ids
+	 * @tparam T The type of the integers in the sequence
+	*/
+	template<typename T>
+	struct elias_fano;
+
+	/**
+	 * @brief A read-only view into an Elias-Fano encoded sequence, which queries the bits directly in the buffer it was read from
+	 * @note Does not take ownership of the buffer, so it must outlive the view
+	 * @tparam T The type of the integers in the sequence
+	*/
+	template<typename T>
+	class elias_fano_view
+	{
+	public:
+		/**
+		 * @brief The number of ones or zeros between each sampled position in the upper bits
+		*/
+		static constexpr uint32_t sample_rate = 64U;
+
+		constexpr elias_fano_view() noexcept :
+			m_Buffer(nullptr),
+			m_Size(0),
+			m_LowBits(0),
+			m_NumZeros(0),
+			m_PositionBits(0),
+			m_OneSampleOffset(0),
+			m_ZeroSampleOffset(0),
+			m_LowOffset(0),
+			m_UpperOffset(0) {}
+
+		/**
+		 * @brief Returns the number of integers in the sequence
+		 * @return The number of integers in the sequence
+		*/
+		[[nodiscard]] uint32_t size() const noexcept { return m_Size; }
+
+		/**
+		 * @brief Returns whether the sequence is empty
+		 * @return Whether the sequence is empty
+		*/
+		[[nodiscard]] bool empty() const noexcept { return m_Size == 0U; }
+
+		/**
+		 * @brief Returns the integer at the given @p index in the sequence
+		 * @param index The index of the integer. Must be less than size()
+		 * @return The integer at @p index
+		*/
+		[[nodiscard]] T access(uint32_t index) const noexcept
+		{
+			uint64_t high = select_one(index) - index;
+			uint64_t low = m_LowBits > 0U ? read_bits(m_LowOffset + static_cast<uint64_t>(index) * m_LowBits, m_LowBits) : 0U;
+
+			return static_cast<T>((high << m_LowBits) | low);
+		}
+
+		/**
+		 * @brief Returns the index of the first integer in the sequence which is greater than or equal to @p value
+		 * @param value The value to search for
+		 * @return The index of the first integer not less than @p value, or size() if there is none
+		*/
+		[[nodiscard]] uint32_t next_geq(T value) const noexcept
+		{
+			if (m_Size == 0U)
+				return 0U;
+
+			uint64_t high = static_cast<uint64_t>(value) >> m_LowBits;
+			if (high > m_NumZeros)
+				return m_Size;
+
+			// Jump to the first integer in the bucket of the value's upper bits
+			uint32_t index = 0U;
+			if (high > 0U)
+				index = static_cast<uint32_t>(select_zero(high - 1U) + 1U - high);
+
+			while (index < m_Size && access(index) < value)
+				index++;
+
+			return index;
+		}
+
+		/**
+		 * @brief Returns whether the sequence contains @p value
+		 * @param value The value to search for
+		 * @return Whether the sequence contains @p value
+		*/
+		[[nodiscard]] bool contains(T value) const noexcept
+		{
+			uint32_t index = next_geq(value);
+
+			return index < m_Size && access(index) == value;
+		}
+
+		/**
+		 * @brief Decodes the entire sequence into @p values
+		 * @param values The array to decode into. Must be able to hold size() integers
+		*/
+		void decode(T* values) const noexcept
+		{
+			uint64_t upper_bits = m_Size + m_NumZeros;
+			uint64_t position = 0U;
+			uint32_t index = 0U;
+			while (position < upper_bits && index < m_Size)
+			{
+				uint32_t num_bits = static_cast<uint32_t>((std::min)(upper_bits - position, uint64_t(64U)));
+				uint64_t chunk = read_bits(m_UpperOffset + position, num_bits) << (64U - num_bits);
+
+				while (chunk != 0U && index < m_Size)
+				{
+					uint32_t offset = utility::count_leading_zeros64(chunk);
+					chunk &= ~(1ULL << (63U - offset));
+
+					uint64_t high = position + offset - index;
+					uint64_t low = m_LowBits > 0U ? read_bits(m_LowOffset + static_cast<uint64_t>(index) * m_LowBits, m_LowBits) : 0U;
+
+					values[index++] = static_cast<T>((high << m_LowBits) | low);
+				}
+
+				position += num_bits;
+			}
+		}
+
+	private:
+		template<typename, typename>
+		friend struct serialize_traits;
+
+		uint64_t read_bits(uint64_t bit_offset, uint32_t num_bits) const noexcept
+		{
+			if (num_bits > 32U)
+			{
+				// Split it up so that each half fits within 5 bytes
+				uint64_t high = read_bits(bit_offset, num_bits - 32U);
+
+				return (high << 32U) | read_bits(bit_offset + num_bits - 32U, 32U);
+			}
+
+			// The stream stores words in big-endian, so the bits are ordered from the most significant bit of each byte
+			const uint8_t* ptr = m_Buffer + bit_offset / 8U;
+			uint32_t skip = static_cast<uint32_t>(bit_offset % 8U);
+			uint32_t num_bytes = (skip + num_bits + 7U) / 8U;
+
+			uint64_t value = 0U;
+			for (uint32_t i = 0U; i < num_bytes; i++)
+				value = (value << 8U) | ptr[i];
+
+			value >>= num_bytes * 8U - skip - num_bits;
+
+			return value & ((1ULL << num_bits) - 1U);
+		}
+
+		uint64_t select_one(uint32_t rank) const noexcept
+		{
+			uint64_t position = read_bits(m_OneSampleOffset + static_cast<uint64_t>(rank / sample_rate) * m_PositionBits, m_PositionBits);
+
+			return select(position, rank % sample_rate, false);
+		}
+
+		uint64_t select_zero(uint64_t rank) const noexcept
+		{
+			uint64_t position = read_bits(m_ZeroSampleOffset + (rank / sample_rate) * m_PositionBits, m_PositionBits);
+
+			return select(position, static_cast<uint32_t>(rank % sample_rate), true);
+		}
+
+		static uint32_t select_in_chunk(uint64_t chunk, uint32_t rank) noexcept
+		{
+			// Clear the set bits before the one we are looking for
+			for (uint32_t i = 0U; i < rank; i++)
+				chunk &= ~(1ULL << (63U - utility::count_leading_zeros64(chunk)));
+
+			return utility::count_leading_zeros64(chunk);
+		}
+
+		uint64_t select(uint64_t position, uint32_t rank, bool zeros) const noexcept
+		{
+			uint64_t upper_bits = m_Size + m_NumZeros;
+			while (position < upper_bits)
+			{
+				uint32_t num_bits = static_cast<uint32_t>((std::min)(upper_bits - position, uint64_t(64U)));
+				uint64_t chunk = read_bits(m_UpperOffset + position, num_bits);
+				if (zeros)
+					chunk = ~chunk;
+				chunk <<= 64U - num_bits;
+
+				uint32_t count = utility::popcount64(chunk);
+				if (rank < count)
+					return position + select_in_chunk(chunk, rank);
+
+				rank -= count;
+				position += num_bits;
+			}
+
+			return upper_bits;
+		}
+
+		/**
+		 * @brief Checks that the upper bits contain exactly size() ones, and that every sampled position matches the upper bits,
+		 * so that queries on a view read from an untrusted stream stay within the sequence
+		 * @return Whether the view is consistent
+		*/
+		bool validate() const noexcept
+		{
+			uint64_t upper_bits = m_Size + m_NumZeros;
+			uint64_t num_ones = 0U;
+			uint64_t one_rank = 0U;
+			uint64_t zero_rank = 0U;
+			for (uint64_t position = 0U; position < upper_bits; position += 64U)
+			{
+				uint32_t num_bits = static_cast<uint32_t>((std::min)(upper_bits - position, uint64_t(64U)));
+				uint64_t chunk = read_bits(m_UpperOffset + position, num_bits) << (64U - num_bits);
+				uint64_t zero_chunk = ~chunk & (~0ULL << (64U - num_bits));
+
+				uint32_t chunk_ones = utility::popcount64(chunk);
+				uint64_t num_zeros = position - num_ones;
+
+				if (num_ones + chunk_ones > m_Size || num_zeros + num_bits - chunk_ones > m_NumZeros)
+					return false;
+
+				for (; one_rank < num_ones + chunk_ones; one_rank += sample_rate)
+				{
+					uint64_t sample = read_bits(m_OneSampleOffset + (one_rank / sample_rate) * m_PositionBits, m_PositionBits);
+					if (sample != position + select_in_chunk(chunk, static_cast<uint32_t>(one_rank - num_ones)))
+						return false;
+				}
+
+				for (; zero_rank < num_zeros + num_bits - chunk_ones; zero_rank += sample_rate)
+				{
+					uint64_t sample = read_bits(m_ZeroSampleOffset + (zero_rank / sample_rate) * m_PositionBits, m_PositionBits);
+					if (sample != position + select_in_chunk(zero_chunk, static_cast<uint32_t>(zero_rank - num_zeros)))
+						return false;
+				}
+
+				num_ones += chunk_ones;
+			}
+
+			return num_ones == m_Size;
+		}
+
+	private:
+		const uint8_t* m_Buffer;
+		uint32_t m_Size;
+		uint32_t m_LowBits;
+		uint64_t m_NumZeros;
+		uint32_t m_PositionBits;
+		uint64_t m_OneSampleOffset;
+		uint64_t m_ZeroSampleOffset;
+		uint64_t m_LowOffset;
+		uint64_t m_UpperOffset;
+	};
+
+	/**
+	 * @brief A trait used to serialize monotone sequences of unsigned integers using Elias-Fano encoding.
+	 * Each integer is split into lower bits, which are stored as-is, and upper bits, which are stored in unary.
+	 * Sampled positions of the upper bits are stored as well, so the sequence can be queried without decoding it.
+	 * @tparam T The type of the integers in the sequence
+	*/
+	template<typename T>
+	struct serialize_traits<elias_fano<T>, typename std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_const_v<T>>>
+	{
+		static_assert(sizeof(T) <= 8, "Integers larger than 8 bytes are currently not supported");
+
+	private:
+		static constexpr uint32_t sample_rate = elias_fano_view<T>::sample_rate;
+
+		static constexpr uint32_t get_low_bits(uint32_t size, uint64_t max) noexcept
+		{
+			uint64_t ratio = max / size;
+
+			return ratio > 0U ? utility::bits_to_represent(ratio) - 1U : 0U;
+		}
+
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize_wide(Stream& writer, uint64_t value, uint32_t num_bits) noexcept
+		{
+			if (num_bits > 32U)
+			{
+				// If the value is bigger than a word (32 bits)
+				BS_ASSERT(writer.serialize_bits(static_cast<uint32_t>(value >> 32U), num_bits - 32U));
+
+				return writer.serialize_bits(static_cast<uint32_t>(value), 32U);
+			}
+
+			return writer.serialize_bits(static_cast<uint32_t>(value), num_bits);
+		}
+
+	public:
+		/**
+		 * @brief Writes a monotone sequence of integers into the @p writer
+		 * @param writer The stream to write to
+		 * @param values The integers to serialize, sorted in non-decreasing order
+		 * @param size The number of integers in @p values
+		 * @param max_size The maximum expected number of integers
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const T* values, uint32_t size, uint32_t max_size) noexcept
+		{
+			BS_ASSERT(size <= max_size);
+
+			BS_ASSERT(writer.serialize_bits(size, utility::bits_to_represent(max_size)));
+
+			if (size == 0U)
+				return true;
+
+			for (uint32_t i = 1U; i < size; i++)
+				BS_ASSERT(values[i - 1U] <= values[i]);
+
+			T max = values[size - 1U];
+			BS_ASSERT(writer.template serialize<bounded_int<T>>(max));
+
+			uint32_t low_bits = get_low_bits(size, max);
+			uint64_t num_zeros = static_cast<uint64_t>(max) >> low_bits;
+			uint32_t position_bits = utility::bits_to_represent(size + num_zeros);
+
+			// Sample the position of every nth one
+			for (uint32_t i = 0U; i < size; i += sample_rate)
+				BS_ASSERT(serialize_wide(writer, (static_cast<uint64_t>(values[i]) >> low_bits) + i, position_bits));
+
+			// Sample the position of every nth zero
+			uint32_t index = 0U;
+			for (uint64_t zero = 0U; zero < num_zeros; zero += sample_rate)
+			{
+				while (index < size && (static_cast<uint64_t>(values[index]) >> low_bits) <= zero)
+					index++;
+
+				BS_ASSERT(serialize_wide(writer, zero + index, position_bits));
+			}
+
+			// Write the lower bits as-is
+			if (low_bits > 0U)
+			{
+				uint64_t mask = (1ULL << low_bits) - 1U;
+				for (uint32_t i = 0U; i < size; i++)
+					BS_ASSERT(serialize_wide(writer, static_cast<uint64_t>(values[i]) & mask, low_bits));
+			}
+
+			// Write the upper bits in unary, as a run of zeros followed by a one
+			uint64_t position = 0U;
+			for (uint32_t i = 0U; i < size; i++)
+			{
+				uint64_t target = (static_cast<uint64_t>(values[i]) >> low_bits) + i;
+				uint64_t gap = target - position;
+
+				for (; gap >= 32U; gap -= 32U)
+					BS_ASSERT(writer.serialize_bits(0U, 32U));
+
+				BS_ASSERT(writer.serialize_bits(1U, static_cast<uint32_t>(gap) + 1U));
+
+				position = target + 1U;
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads a monotone sequence of integers into a view, which can be queried without decoding the sequence
+		 * @param reader The stream to read from
+		 * @param view The view to read into. Will reference the reader's buffer
+		 * @param max_size The maximum expected number of integers
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, elias_fano_view<T>& view, uint32_t max_size) noexcept
+		{
+			static_assert(utility::has_buffer_v<Stream>, "An elias_fano_view references the reader's buffer directly, so it can't be read from a segmented_bit_reader");
+
+			uint32_t size;
+			BS_ASSERT(reader.serialize_bits(size, utility::bits_to_represent(max_size)));
+
+			BS_ASSERT(size <= max_size);
+
+			view = elias_fano_view<T>();
+
+			if (size == 0U)
+				return true;
+
+			T max;
+			BS_ASSERT(reader.template serialize<bounded_int<T>>(max));
+
+			uint32_t low_bits = get_low_bits(size, max);
+			uint64_t num_zeros = static_cast<uint64_t>(max) >> low_bits;
+			uint32_t position_bits = utility::bits_to_represent(size + num_zeros);
+
+			uint64_t num_one_samples = (size - 1U) / sample_rate + 1U;
+			uint64_t num_zero_samples = num_zeros > 0U ? (num_zeros - 1U) / sample_rate + 1U : 0U;
+
+			uint64_t num_sample_bits = (num_one_samples + num_zero_samples) * position_bits;
+			uint64_t num_bits = num_sample_bits + static_cast<uint64_t>(size) * low_bits + size + num_zeros;
+
+			BS_ASSERT(num_bits <= reader.get_remaining_bits());
+
+			uint64_t offset = reader.get_num_bits_serialized();
+
+			view.m_Buffer = reader.get_buffer();
+			view.m_Size = size;
+			view.m_LowBits = low_bits;
+			view.m_NumZeros = num_zeros;
+			view.m_PositionBits = position_bits;
+			view.m_OneSampleOffset = offset;
+			view.m_ZeroSampleOffset = offset + num_one_samples * position_bits;
+			view.m_LowOffset = offset + num_sample_bits;
+			view.m_UpperOffset = view.m_LowOffset + static_cast<uint64_t>(size) * low_bits;
+
+			BS_ASSERT(view.validate());
+
+			// Skip past the encoded sequence without decoding it
+			uint32_t value;
+			for (; num_bits >= 32U; num_bits -= 32U)
+				BS_ASSERT(reader.serialize_bits(value, 32U));
+
+			if (num_bits > 0U)
+				BS_ASSERT(reader.serialize_bits(value, static_cast<uint32_t>(num_bits)));
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads and decodes a monotone sequence of integers into @p values
+		 * @param reader The stream to read from
+		 * @param values The array to read into. Must be able to hold @p max_size integers
+		 * @param size Returns the number of integers that were read
+		 * @param max_size The maximum expected number of integers
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, T* values, out<uint32_t> size, uint32_t max_size) noexcept
+		{
+			elias_fano_view<T> view;
+			BS_ASSERT(serialize(reader, view, max_size));
+
+			view.decode(values);
+
+			size = view.size();
+
+			return true;
+		}
+	};
+}
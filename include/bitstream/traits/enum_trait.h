@@ -1,5 +1,6 @@
 #pragma once
 #include "../utility/assert.h"
+#include "../utility/huffman.h"
 #include "../utility/meta.h"
 #include "../utility/parameter.h"
 
@@ -16,6 +17,14 @@ namespace bitstream
 	template<typename T, std::underlying_type_t<T> = (std::numeric_limits<T>::min)(), std::underlying_type_t<T> = (std::numeric_limits<T>::max)()>
 	struct bounded_enum;
 
+	/**
+	 * @brief Wrapper type for enums with a static canonical Huffman code
+	 * @tparam T The enum type. Its values must lie within [0, sizeof...(Frequencies))
+	 * @tparam ...Frequencies The relative frequency of each value, indexed by its underlying value. Values with a frequency of 0 cannot be serialized
+	*/
+	template<typename T, uint32_t... Frequencies>
+	struct huffman_enum;
+
 	/**
 	 * @brief A trait used to serialize an enum type with runtime bounds
 	*/
@@ -78,4 +87,64 @@ namespace bitstream
 			return true;
 		}
 	};
+
+	/**
+	 * @brief A trait used to serialize an enum type with a canonical Huffman code, built at compiletime from the given frequencies.
+	 * Frequent values are given shorter codes, with every value written in a single call.
+	*/
+	template<typename T, uint32_t... Frequencies>
+	struct serialize_traits<huffman_enum<T, Frequencies...>, typename std::enable_if_t<std::is_enum_v<T>>>
+	{
+		static_assert(((Frequencies > 0U) || ...), "At least one value must have a frequency above 0");
+
+		using value_type = std::underlying_type_t<T>;
+		using unsigned_type = std::make_unsigned_t<value_type>;
+
+		static constexpr size_t num_symbols = sizeof...(Frequencies);
+		static constexpr uint32_t frequencies[num_symbols] = { Frequencies... };
+		static constexpr utility::huffman_code<num_symbols> code = utility::make_huffman_code(frequencies);
+
+		/**
+		 * @brief Writes an enum value into the @p writer, using its Huffman code
+		 * @param writer The stream to write to
+		 * @param value The value to serialize. Must have a frequency above 0
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, T value) noexcept
+		{
+			unsigned_type symbol = static_cast<unsigned_type>(static_cast<value_type>(value));
+
+			BS_ASSERT(symbol < num_symbols && code.lengths[symbol] > 0U);
+
+			return writer.serialize_bits(code.codes[symbol], code.lengths[symbol]);
+		}
+
+		/**
+		 * @brief Reads an enum value from the @p reader, by decoding its Huffman code
+		 * @param reader The stream to read from
+		 * @param value The value to read into
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, T& value) noexcept
+		{
+			// Decode from the upcoming bits, then skip past the code that was actually used
+			uint32_t window;
+			BS_ASSERT(reader.peek_bits(window, code.max_length));
+
+			uint32_t symbol;
+			uint32_t length;
+			BS_ASSERT(code.decode(window, symbol, length));
+
+			uint32_t code_bits;
+			BS_ASSERT(reader.serialize_bits(code_bits, length));
+
+			value = static_cast<T>(static_cast<value_type>(symbol));
+
+			return true;
+		}
+	};
 }
\ No newline at end of file
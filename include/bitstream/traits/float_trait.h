@@ -1,5 +1,6 @@
 #pragma once
 #include "../utility/assert.h"
+#include "../utility/bits.h"
 #include "../utility/meta.h"
 #include "../utility/parameter.h"
 
@@ -99,4 +100,153 @@ namespace bitstream
 			return true;
 		}
 	};
+
+	/**
+	 * @brief Wrapper type for sequences of slowly changing floats, like telemetry or replay samples
+	*/
+	struct xor_float_sequence;
+
+	/**
+	 * @brief A trait used to serialize a sequence of floats by XORing each value with the previous one.
+	 * The first value is written as-is. Each following value writes a single 0 bit if it is unchanged,
+	 * otherwise the meaningful bits of the XOR, either inside the window of the previous XOR (control bits 10)
+	 * or with a new window given as 5 bits of leading zeros and 5 bits of length (control bits 11)
+	*/
+	template<>
+	struct serialize_traits<xor_float_sequence>
+	{
+		/**
+		 * @brief Serializes a sequence of floats into the writer, using one write per value
+		 * @param writer The stream to write to
+		 * @param values The floats to serialize
+		 * @param count The number of floats
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const float* values, uint32_t count) noexcept
+		{
+			if (count == 0U)
+				return true;
+
+			uint32_t previous;
+			std::memcpy(&previous, values, sizeof(float));
+
+			BS_ASSERT(writer.serialize_bits(previous, 32U));
+
+			// No XOR has 32 leading zeros, so the first one always starts a new window
+			uint32_t window_leading = 32U;
+			uint32_t window_trailing = 0U;
+
+			for (uint32_t i = 1U; i < count; i++)
+			{
+				uint32_t current;
+				std::memcpy(&current, values + i, sizeof(float));
+
+				uint32_t difference = current ^ previous;
+				previous = current;
+
+				if (difference == 0U)
+				{
+					BS_ASSERT(writer.serialize_bits(0U, 1U));
+					continue;
+				}
+
+				uint32_t leading = utility::count_leading_zeros64(difference) - 32U;
+				uint32_t trailing = utility::count_trailing_zeros64(difference);
+
+				if (leading >= window_leading && trailing >= window_trailing)
+				{
+					// Control bits, followed by the bits inside the previous window
+					uint32_t meaningful = 32U - window_leading - window_trailing;
+					uint64_t fields = (0b10ULL << meaningful) | (difference >> window_trailing);
+
+					BS_ASSERT(writer.serialize_bits(fields, 2U + meaningful));
+				}
+				else
+				{
+					// Control bits, leading zeros and length, followed by the bits inside the new window
+					uint32_t meaningful = 32U - leading - trailing;
+					uint64_t header = (0b11ULL << 10U) | (leading << 5U) | (meaningful - 1U);
+					uint64_t fields = (header << meaningful) | (difference >> trailing);
+
+					BS_ASSERT(writer.serialize_bits(fields, 12U + meaningful));
+
+					window_leading = leading;
+					window_trailing = trailing;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Serializes a sequence of floats from the reader
+		 * @param reader The stream to read from
+		 * @param values The floats to serialize to
+		 * @param count The number of floats
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, float* values, uint32_t count) noexcept
+		{
+			if (count == 0U)
+				return true;
+
+			uint32_t previous;
+			BS_ASSERT(reader.serialize_bits(previous, 32U));
+
+			std::memcpy(values, &previous, sizeof(float));
+
+			uint32_t window_leading = 32U;
+			uint32_t window_trailing = 0U;
+
+			for (uint32_t i = 1U; i < count; i++)
+			{
+				// The largest header is 2 control bits, 5 bits of leading zeros and 5 bits of length
+				uint32_t header;
+				BS_ASSERT(reader.peek_bits(header, 12U));
+
+				uint32_t difference = 0U;
+				if ((header >> 11U) == 0U)
+				{
+					uint32_t control;
+					BS_ASSERT(reader.serialize_bits(control, 1U));
+				}
+				else if ((header >> 10U) == 0b10U)
+				{
+					BS_ASSERT(window_leading < 32U);
+
+					uint32_t meaningful = 32U - window_leading - window_trailing;
+
+					uint64_t fields;
+					BS_ASSERT(reader.serialize_bits(fields, 2U + meaningful));
+
+					difference = static_cast<uint32_t>(fields & ((1ULL << meaningful) - 1U)) << window_trailing;
+				}
+				else
+				{
+					uint32_t leading = (header >> 5U) & 0x1FU;
+					uint32_t meaningful = (header & 0x1FU) + 1U;
+
+					BS_ASSERT(leading + meaningful <= 32U);
+
+					uint64_t fields;
+					BS_ASSERT(reader.serialize_bits(fields, 12U + meaningful));
+
+					window_leading = leading;
+					window_trailing = 32U - leading - meaningful;
+
+					difference = static_cast<uint32_t>(fields & ((1ULL << meaningful) - 1U)) << window_trailing;
+				}
+
+				previous ^= difference;
+
+				std::memcpy(values + i, &previous, sizeof(float));
+			}
+
+			return true;
+		}
+	};
 }
\ No newline at end of file
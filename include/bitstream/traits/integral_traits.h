@@ -6,6 +6,7 @@
 
 #include "../stream/serialize_traits.h"
 
+#include <array>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
@@ -19,6 +20,9 @@ namespace bitstream
 	template<typename T, T = (std::numeric_limits<T>::min)(), T = (std::numeric_limits<T>::max)()>
 	struct bounded_int;
 
+	template<typename T>
+	class int_range;
+
 #pragma region const integral types
 	/**
 	 * @brief A trait used to serialize integer values with compiletime bounds
@@ -27,9 +31,13 @@ namespace bitstream
 	 * @tparam Max The upper bound. Inclusive
 	*/
 	template<typename T, T Min, T Max>
-	struct serialize_traits<bounded_int<T, Min, Max>, typename std::enable_if_t<std::is_integral_v<T> && !std::is_const_v<T>>>
+	struct serialize_traits<bounded_int<T, Min, Max>, typename std::enable_if_t<utility::is_integral_v<T> && !std::is_const_v<T>>>
 	{
-		static_assert(sizeof(T) <= 8, "Integers larger than 8 bytes are currently not supported. You will have to write this functionality yourself");
+		static_assert(sizeof(T) <= 16, "Integers larger than 16 bytes are currently not supported. You will have to write this functionality yourself");
+
+		static_assert(Min < Max);
+
+		static constexpr int_range<T> range = int_range<T>(Min, Max);
 
 		/**
 		 * @brief Writes an integer into the @p writer
@@ -41,62 +49,241 @@ namespace bitstream
 		typename utility::is_writing_t<Stream>
 		static serialize(Stream& writer, in<T> value) noexcept
 		{
-			static_assert(Min < Max);
+			return serialize_traits<int_range<T>>::serialize(writer, range, value);
+		}
+
+		/**
+		 * @brief Reads an integer from the @p writer into @p value
+		 * @param reader The stream to read from
+		 * @param value The value to serialize
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, T& value) noexcept
+		{
+			return serialize_traits<int_range<T>>::serialize(reader, range, value);
+		}
+	};
+#pragma endregion
+
+#pragma region integral types
+	/**
+	 * @brief A trait used to serialize integer values with runtime bounds
+	 * @tparam T A type matching an integer value
+	*/
+	template<typename T>
+	struct serialize_traits<T, typename std::enable_if_t<utility::is_integral_v<T> && !std::is_const_v<T>>>
+	{
+		static_assert(sizeof(T) <= 16, "Integers larger than 16 bytes are currently not supported. You will have to write this functionality yourself");
+
+		/**
+		 * @brief Writes an integer into the @p writer
+		 * @param writer The stream to write to
+		 * @param value The value to serialize
+		 * @param min The minimum bound that @p value can be. Inclusive
+		 * @param max The maximum bound that @p value can be. Inclusive
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, in<T> value, T min, T max) noexcept
+		{
+			BS_ASSERT(min < max);
+
+			return serialize_traits<int_range<T>>::serialize(writer, int_range<T>(min, max), value);
+		}
+
+		/**
+		 * @brief Reads an integer from the @p reader into @p value
+		 * @param reader The stream to read from
+		 * @param value The value to read into
+		 * @param min The minimum bound that @p value can be. Inclusive
+		 * @param max The maximum bound that @p value can be. Inclusive
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, T& value, T min, T max) noexcept
+		{
+			BS_ASSERT(min < max);
+
+			return serialize_traits<int_range<T>>::serialize(reader, int_range<T>(min, max), value);
+		}
+
+		/**
+		 * @brief Writes or reads an integer into the @p stream
+		 * @param stream The stream to serialize to/from
+		 * @param value The value to serialize
+		 * @return Success
+		*/
+		template<typename Stream, typename U>
+		static bool serialize(Stream& stream, U&& value) noexcept
+		{
+			return serialize_traits<bounded_int<T>>::serialize(stream, std::forward<U>(value));
+		}
+	};
+#pragma endregion
+
+#pragma region runtime integral range
+	/**
+	 * @brief Class for integer bounds which are only known at runtime, but reused for many values.
+	 * The number of bits required is computed once on construction, instead of on every serialization.
+	 * @tparam T A type matching an integer value
+	*/
+	template<typename T>
+	class int_range
+	{
+	public:
+		using unsigned_type = utility::make_unsigned_t<T>;
+
+		constexpr int_range() noexcept :
+			m_Min(0),
+			m_Max(0),
+			m_BitsRequired(0) {}
 
-			BS_ASSERT(value >= Min && value <= Max);
+		/**
+		 * @brief Construct a range with the given bounds
+		 * @param min The lower bound. Inclusive
+		 * @param max The upper bound. Inclusive. Must not be less than @p min
+		*/
+		constexpr int_range(T min, T max) noexcept :
+			m_Min(min),
+			m_Max(max),
+			m_BitsRequired(get_bits_in_range(min, max)) {}
 
-			constexpr uint32_t num_bits = utility::bits_in_range(Min, Max);
+		constexpr inline T get_min() const noexcept { return m_Min; }
+		constexpr inline T get_max() const noexcept { return m_Max; }
+		constexpr inline uint32_t get_bits_required() const noexcept { return m_BitsRequired; }
 
-			static_assert(num_bits <= sizeof(T) * 8);
+	private:
+		static constexpr uint32_t get_bits_in_range(T min, T max) noexcept
+		{
+			unsigned_type range = static_cast<unsigned_type>(static_cast<unsigned_type>(max) - static_cast<unsigned_type>(min));
 
-			if constexpr (sizeof(T) > 4 && num_bits > 32)
+			if constexpr (sizeof(T) > 8)
 			{
-				// If the given range is bigger than a word (32 bits)
-				uint32_t unsigned_value = static_cast<uint32_t>(value - Min);
-				BS_ASSERT(writer.serialize_bits(unsigned_value, 32));
+				uint64_t high = static_cast<uint64_t>(range >> 64U);
+				if (high != 0U)
+					return 64U + utility::bits_to_represent(high);
+			}
+
+			return utility::bits_to_represent(static_cast<uint64_t>(range));
+		}
 
-				unsigned_value = static_cast<uint32_t>((value - Min) >> 32);
-				BS_ASSERT(writer.serialize_bits(unsigned_value, num_bits - 32));
+	private:
+		T m_Min;
+		T m_Max;
+
+		uint32_t m_BitsRequired;
+	};
+
+	/**
+	 * @brief A trait used to serialize integer values within a precomputed runtime range.
+	 * Uses the same representation as serializing with runtime bounds, but skips recalculating the number of bits.
+	 * @tparam T A type matching an integer value
+	*/
+	template<typename T>
+	struct serialize_traits<int_range<T>, typename std::enable_if_t<utility::is_integral_v<T> && !std::is_const_v<T>>>
+	{
+		static_assert(sizeof(T) <= 16, "Integers larger than 16 bytes are currently not supported. You will have to write this functionality yourself");
+
+		using unsigned_type = utility::make_unsigned_t<T>;
+
+		/**
+		 * @brief Writes an integer into the @p writer
+		 * @param writer The stream to write to
+		 * @param range The range that @p value is within
+		 * @param value The value to serialize
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, in<int_range<T>> range, in<T> value) noexcept
+		{
+			BS_ASSERT(value >= range.get_min() && value <= range.get_max());
+
+			uint32_t num_bits = range.get_bits_required();
+
+			// There's only one possible value
+			if (num_bits == 0U)
+				return true;
+
+			unsigned_type offset = static_cast<unsigned_type>(static_cast<unsigned_type>(value) - static_cast<unsigned_type>(range.get_min()));
+
+			if constexpr (sizeof(T) > 8)
+			{
+				if (num_bits > 64U)
+				{
+					// If the given range is bigger than 64 bits, the lower 64 bits are written first
+					BS_ASSERT(writer.serialize_bits(static_cast<uint64_t>(offset), 64U));
+
+					return writer.serialize_bits(static_cast<uint64_t>(offset >> 64U), num_bits - 64U);
+				}
 			}
-			else
+
+			if constexpr (sizeof(T) > 4)
 			{
-				// If the given range is smaller than or equal to a word (32 bits)
-				uint32_t unsigned_value = static_cast<uint32_t>(value - Min);
-				BS_ASSERT(writer.serialize_bits(unsigned_value, num_bits));
+				if (num_bits > 32U)
+				{
+					// If the given range is bigger than a word (32 bits), the lower word is written first
+					// Rotating the halves lets us write both in a single 64-bit store
+					uint64_t low = static_cast<uint32_t>(offset);
+					uint64_t high = static_cast<uint64_t>(offset) >> 32U;
+
+					return writer.serialize_bits((low << (num_bits - 32U)) | high, num_bits);
+				}
 			}
 
-			return true;
+			// If the given range is smaller than or equal to a word (32 bits)
+			return writer.serialize_bits(static_cast<uint32_t>(offset), num_bits);
 		}
 
 		/**
-		 * @brief Reads an integer from the @p writer into @p value
+		 * @brief Reads an integer from the @p reader into @p value
 		 * @param reader The stream to read from
-		 * @param value The value to serialize
+		 * @param range The range that @p value is within
+		 * @param value The value to read into
 		 * @return Success
 		*/
 		template<typename Stream>
 		typename utility::is_reading_t<Stream>
-		static serialize(Stream& reader, T& value) noexcept
+		static serialize(Stream& reader, in<int_range<T>> range, T& value) noexcept
 		{
-			static_assert(Min < Max);
+			uint32_t num_bits = range.get_bits_required();
 
-			constexpr uint32_t num_bits = utility::bits_in_range(Min, Max);
+			// There's only one possible value
+			if (num_bits == 0U)
+			{
+				value = range.get_min();
+				return true;
+			}
 
-			static_assert(num_bits <= sizeof(T) * 8);
+			unsigned_type offset;
 
-			if constexpr (sizeof(T) > 4 && num_bits > 32)
+			if (sizeof(T) > 8 && num_bits > 64U)
 			{
-				// If the given range is bigger than a word (32 bits)
-				value = 0;
-				uint32_t unsigned_value;
-
-				BS_ASSERT(reader.serialize_bits(unsigned_value, 32));
-				value |= static_cast<T>(unsigned_value);
+				// If the given range is bigger than 64 bits, the lower 64 bits are read first
+				uint64_t low;
+				uint64_t high;
+				BS_ASSERT(reader.serialize_bits(low, 64U));
+				BS_ASSERT(reader.serialize_bits(high, num_bits - 64U));
+
+				offset = static_cast<unsigned_type>(low);
+				if constexpr (sizeof(T) > 8)
+					offset |= static_cast<unsigned_type>(high) << 64U;
+			}
+			else if (sizeof(T) > 4 && num_bits > 32U)
+			{
+				// If the given range is bigger than a word (32 bits), the lower word is read first
+				uint64_t bits;
+				BS_ASSERT(reader.serialize_bits(bits, num_bits));
 
-				BS_ASSERT(reader.serialize_bits(unsigned_value, num_bits - 32));
-				value |= static_cast<T>(unsigned_value) << 32;
+				uint32_t high_bits = num_bits - 32U;
+				uint64_t low = bits >> high_bits;
+				uint64_t high = bits & ((1ULL << high_bits) - 1U);
 
-				value += Min;
+				offset = static_cast<unsigned_type>((high << 32U) | low);
 			}
 			else
 			{
@@ -104,28 +291,31 @@ namespace bitstream
 				uint32_t unsigned_value;
 				BS_ASSERT(reader.serialize_bits(unsigned_value, num_bits));
 
-				value = static_cast<T>(unsigned_value) + Min;
+				offset = static_cast<unsigned_type>(unsigned_value);
 			}
 
-			BS_ASSERT(value >= Min && value <= Max);
+			value = static_cast<T>(static_cast<unsigned_type>(static_cast<unsigned_type>(range.get_min()) + offset));
+
+			BS_ASSERT(value >= range.get_min() && value <= range.get_max());
 
 			return true;
 		}
 	};
 #pragma endregion
 
-#pragma region integral types
+#pragma region portable 128-bit integral types
 	/**
-	 * @brief A trait used to serialize integer values with runtime bounds
-	 * @tparam T A type matching an integer value
+	 * @brief A trait used to serialize 128-bit unsigned integers on compilers without a native 128-bit type.
+	 * The most significant half is stored first, so the arrays compare like the integers they represent.
+	 * Uses the same representation as serializing an unsigned __int128 with runtime bounds.
 	*/
-	template<typename T>
-	struct serialize_traits<T, typename std::enable_if_t<std::is_integral_v<T> && !std::is_const_v<T>>>
+	template<>
+	struct serialize_traits<std::array<uint64_t, 2>>
 	{
-		static_assert(sizeof(T) <= 8, "Integers larger than 8 bytes are currently not supported. You will have to write this functionality yourself");
+		using value_type = std::array<uint64_t, 2>;
 
 		/**
-		 * @brief Writes an integer into the @p writer
+		 * @brief Writes a 128-bit integer into the @p writer
 		 * @param writer The stream to write to
 		 * @param value The value to serialize
 		 * @param min The minimum bound that @p value can be. Inclusive
@@ -134,40 +324,26 @@ namespace bitstream
 		*/
 		template<typename Stream>
 		typename utility::is_writing_t<Stream>
-		static serialize(Stream& writer, in<T> value, T min, T max) noexcept
+		static serialize(Stream& writer, in<value_type> value, in<value_type> min, in<value_type> max) noexcept
 		{
 			BS_ASSERT(min < max);
-            
-            BS_ASSERT(value >= min && value <= max);
-
-			uint32_t num_bits = utility::bits_in_range(min, max);
 
-			BS_ASSERT(num_bits <= sizeof(T) * 8);
-
-			if constexpr (sizeof(T) > 4)
-			{
-				if (num_bits > 32)
-				{
-					// If the given range is bigger than a word (32 bits)
-					uint32_t unsigned_value = static_cast<uint32_t>(value - min);
-					BS_ASSERT(writer.serialize_bits(unsigned_value, 32));
+			BS_ASSERT(value >= min && value <= max);
 
-					unsigned_value = static_cast<uint32_t>((value - min) >> 32);
-					BS_ASSERT(writer.serialize_bits(unsigned_value, num_bits - 32));
+			value_type range = subtract(max, min);
+			value_type offset = subtract(value, min);
 
-					return true;
-				}
-			}
+			if (range[0] == 0U)
+				return serialize_traits<int_range<uint64_t>>::serialize(writer, int_range<uint64_t>(0U, range[1]), offset[1]);
 
-			// If the given range is smaller than or equal to a word (32 bits)
-			uint32_t unsigned_value = static_cast<uint32_t>(value - min);
-			BS_ASSERT(writer.serialize_bits(unsigned_value, num_bits));
+			// The lower 64 bits are written first
+			BS_ASSERT(writer.serialize_bits(offset[1], 64U));
 
-			return true;
+			return writer.serialize_bits(offset[0], utility::bits_to_represent(range[0]));
 		}
 
 		/**
-		 * @brief Reads an integer from the @p reader into @p value
+		 * @brief Reads a 128-bit integer from the @p reader into @p value
 		 * @param reader The stream to read from
 		 * @param value The value to read into
 		 * @param min The minimum bound that @p value can be. Inclusive
@@ -176,49 +352,33 @@ namespace bitstream
 		*/
 		template<typename Stream>
 		typename utility::is_reading_t<Stream>
-		static serialize(Stream& reader, T& value, T min, T max) noexcept
+		static serialize(Stream& reader, value_type& value, in<value_type> min, in<value_type> max) noexcept
 		{
 			BS_ASSERT(min < max);
 
-			uint32_t num_bits = utility::bits_in_range(min, max);
-
-			BS_ASSERT(num_bits <= sizeof(T) * 8);
+			value_type range = subtract(max, min);
+			value_type offset{};
 
-			if constexpr (sizeof(T) > 4)
+			if (range[0] == 0U)
 			{
-				if (num_bits > 32)
-				{
-					// If the given range is bigger than a word (32 bits)
-					value = 0;
-					uint32_t unsigned_value;
-
-					BS_ASSERT(reader.serialize_bits(unsigned_value, 32));
-					value |= static_cast<T>(unsigned_value);
-
-					BS_ASSERT(reader.serialize_bits(unsigned_value, num_bits - 32));
-					value |= static_cast<T>(unsigned_value) << 32;
-
-					value += min;
-
-					BS_ASSERT(value >= min && value <= max);
-
-					return true;
-				}
+				BS_ASSERT(serialize_traits<int_range<uint64_t>>::serialize(reader, int_range<uint64_t>(0U, range[1]), offset[1]));
+			}
+			else
+			{
+				// The lower 64 bits are read first
+				BS_ASSERT(reader.serialize_bits(offset[1], 64U));
+				BS_ASSERT(reader.serialize_bits(offset[0], utility::bits_to_represent(range[0])));
 			}
 
-			// If the given range is smaller than or equal to a word (32 bits)
-			uint32_t unsigned_value;
-			BS_ASSERT(reader.serialize_bits(unsigned_value, num_bits));
+			value = add(min, offset);
 
-			value = static_cast<T>(unsigned_value) + min;
-            
-            BS_ASSERT(value >= min && value <= max);
+			BS_ASSERT(value >= min && value <= max);
 
 			return true;
 		}
 
 		/**
-		 * @brief Writes or reads an integer into the @p stream
+		 * @brief Writes or reads a 128-bit integer into the @p stream, using the full range
 		 * @param stream The stream to serialize to/from
 		 * @param value The value to serialize
 		 * @return Success
@@ -226,7 +386,26 @@ namespace bitstream
 		template<typename Stream, typename U>
 		static bool serialize(Stream& stream, U&& value) noexcept
 		{
-			return serialize_traits<bounded_int<T>>::serialize(stream, std::forward<U>(value));
+			constexpr value_type min{ 0U, 0U };
+			constexpr value_type max{ ~0ULL, ~0ULL };
+
+			return serialize(stream, std::forward<U>(value), min, max);
+		}
+
+	private:
+		static value_type subtract(const value_type& lhs, const value_type& rhs) noexcept
+		{
+			uint64_t borrow = lhs[1] < rhs[1] ? 1U : 0U;
+
+			return { lhs[0] - rhs[0] - borrow, lhs[1] - rhs[1] };
+		}
+
+		static value_type add(const value_type& lhs, const value_type& rhs) noexcept
+		{
+			uint64_t low = lhs[1] + rhs[1];
+			uint64_t carry = low < lhs[1] ? 1U : 0U;
+
+			return { lhs[0] + rhs[0] + carry, low };
 		}
 	};
 #pragma endregion
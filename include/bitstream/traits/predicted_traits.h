@@ -0,0 +1,271 @@
+#pragma once
+#include "../quantization/bounded_range.h"
+#include "../quantization/smallest_three.h"
+#include "../utility/assert.h"
+#include "../utility/bits.h"
+#include "../utility/meta.h"
+#include "../utility/parameter.h"
+
+#include "../stream/serialize_traits.h"
+
+#include "../traits/quantization_traits.h"
+
+#include <cstdint>
+
+namespace bitstream
+{
+	/**
+	 * @brief Wrapper type for values serialized as a residual against a prediction known to both sides, like an extrapolated position
+	 * @tparam T The type of the values. Either uint32_t for already quantized values, bounded_range, bounded_vector3<V> or smallest_three<Q, BitsPerElement>
+	*/
+	template<typename T>
+	struct predicted;
+
+	/**
+	 * @brief A trait used to serialize a quantized value as the difference from a quantized prediction.
+	 * The zigzag-encoded difference is written as an Elias gamma code behind a 1 bit, if that is shorter than the value itself.
+	 * Otherwise the value is written as-is behind a 0 bit, so a bad prediction costs at most 1 extra bit
+	*/
+	template<>
+	struct serialize_traits<predicted<uint32_t>>
+	{
+		/**
+		 * @brief Writes a quantized value as a residual into the @p writer
+		 * @param writer The stream to write to
+		 * @param value The quantized value to serialize
+		 * @param prediction The quantized prediction of the value
+		 * @param num_bits The number of bits in the quantized values, between 1 and 32
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, uint32_t value, uint32_t prediction, uint32_t num_bits) noexcept
+		{
+			BS_ASSERT(num_bits > 0U && num_bits <= 32U);
+
+			int64_t residual = static_cast<int64_t>(value) - static_cast<int64_t>(prediction);
+			uint64_t code = ((static_cast<uint64_t>(residual) << 1U) ^ static_cast<uint64_t>(residual >> 63)) + 1U;
+
+			// The gamma code is the length in unary, followed by the code itself
+			uint32_t code_bits = utility::bits_to_represent(code);
+			if (2U * code_bits <= num_bits)
+			{
+				uint32_t word = (1U << (2U * code_bits - 1U)) | static_cast<uint32_t>(code);
+
+				BS_ASSERT(writer.serialize_bits(word, 2U * code_bits));
+			}
+			else
+			{
+				BS_ASSERT(writer.serialize_bits(static_cast<uint64_t>(value), num_bits + 1U));
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads a quantized value as a residual from the @p reader
+		 * @param reader The stream to read from
+		 * @param value The quantized value to read into
+		 * @param prediction The quantized prediction of the value
+		 * @param num_bits The number of bits in the quantized values, between 1 and 32
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, uint32_t& value, uint32_t prediction, uint32_t num_bits) noexcept
+		{
+			BS_ASSERT(num_bits > 0U && num_bits <= 32U);
+
+			uint32_t window;
+			BS_ASSERT(reader.peek_bits(window, 32U));
+
+			if ((window >> 31U) == 0U)
+			{
+				uint64_t raw;
+				BS_ASSERT(reader.serialize_bits(raw, num_bits + 1U));
+
+				value = static_cast<uint32_t>(raw);
+
+				return true;
+			}
+
+			uint32_t code_bits = utility::count_leading_zeros64(static_cast<uint32_t>(window << 1U)) - 31U;
+
+			BS_ASSERT(2U * code_bits <= num_bits);
+
+			uint32_t word;
+			BS_ASSERT(reader.serialize_bits(word, 2U * code_bits));
+
+			uint64_t code = (word & (~0ULL >> (64U - code_bits))) - 1U;
+			int64_t residual = static_cast<int64_t>(code >> 1U) ^ -static_cast<int64_t>(code & 1U);
+			int64_t result = static_cast<int64_t>(prediction) + residual;
+
+			BS_ASSERT(result >= 0 && static_cast<uint64_t>(result) <= (~0ULL >> (64U - num_bits)));
+
+			value = static_cast<uint32_t>(result);
+
+			return true;
+		}
+	};
+
+	/**
+	 * @brief A trait used to quantize and serialize a float as a residual against a predicted float
+	*/
+	template<>
+	struct serialize_traits<predicted<bounded_range>>
+	{
+		/**
+		 * @brief Quantizes and writes a float as a residual into the @p writer
+		 * @param writer The stream to write to
+		 * @param range The range and precision of the float
+		 * @param value The float to serialize
+		 * @param prediction The predicted float, which the reader must also know
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, in<bounded_range> range, in<float> value, in<float> prediction) noexcept
+		{
+			return writer.template serialize<predicted<uint32_t>>(range.quantize(value), range.quantize(prediction), range.get_bits_required());
+		}
+
+		/**
+		 * @brief Reads and dequantizes a float as a residual from the @p reader
+		 * @param reader The stream to read from
+		 * @param range The range and precision of the float
+		 * @param value The float to read into
+		 * @param prediction The predicted float, which the writer must also have used
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, in<bounded_range> range, float& value, in<float> prediction) noexcept
+		{
+			uint32_t quantized;
+			BS_ASSERT(reader.template serialize<predicted<uint32_t>>(quantized, range.quantize(prediction), range.get_bits_required()));
+
+			value = range.dequantize(quantized);
+
+			return true;
+		}
+	};
+
+	/**
+	 * @brief A trait used to quantize and serialize a 3D vector as residuals against a predicted vector, with a bounded_range per axis
+	*/
+	template<typename V>
+	struct serialize_traits<predicted<bounded_vector3<V>>>
+	{
+		/**
+		 * @brief Quantizes and writes a vector as residuals into the @p writer
+		 * @param writer The stream to write to
+		 * @param ranges The range and precision of each axis
+		 * @param value The vector to serialize
+		 * @param prediction The predicted vector, which the reader must also know
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, const bounded_range (&ranges)[3], in<V> value, in<V> prediction) noexcept
+		{
+			for (uint32_t i = 0U; i < 3U; i++)
+				BS_ASSERT(writer.template serialize<predicted<bounded_range>>(ranges[i], value[i], prediction[i]));
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads and dequantizes a vector as residuals from the @p reader
+		 * @param reader The stream to read from
+		 * @param ranges The range and precision of each axis
+		 * @param value The vector to read into
+		 * @param prediction The predicted vector, which the writer must also have used
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, const bounded_range (&ranges)[3], V& value, in<V> prediction) noexcept
+		{
+			float components[3];
+			for (uint32_t i = 0U; i < 3U; i++)
+				BS_ASSERT(reader.template serialize<predicted<bounded_range>>(ranges[i], components[i], prediction[i]));
+
+			value = V{ components[0], components[1], components[2] };
+
+			return true;
+		}
+	};
+
+	/**
+	 * @brief A trait used to quantize and serialize a quaternion as residuals against a predicted quaternion.
+	 * A single bit tells whether the largest component is the same as in the prediction, otherwise it is written in full
+	*/
+	template<typename Q, size_t BitsPerElement>
+	struct serialize_traits<predicted<smallest_three<Q, BitsPerElement>>>
+	{
+		/**
+		 * @brief Quantizes and writes a quaternion as residuals into the @p writer
+		 * @param writer The stream to write to
+		 * @param value The quaternion to serialize
+		 * @param prediction The predicted quaternion, which the reader must also know
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& writer, in<Q> value, in<Q> prediction) noexcept
+		{
+			quantized_quaternion quantized = smallest_three<Q, BitsPerElement>::quantize(value);
+			quantized_quaternion predicted_quat = smallest_three<Q, BitsPerElement>::quantize(prediction);
+
+			if (quantized.m == predicted_quat.m)
+			{
+				BS_ASSERT(writer.serialize_bits(1U, 1U));
+			}
+			else
+			{
+				BS_ASSERT(writer.serialize_bits(quantized.m, 3U));
+			}
+
+			BS_ASSERT(writer.template serialize<predicted<uint32_t>>(quantized.a, predicted_quat.a, static_cast<uint32_t>(BitsPerElement)));
+			BS_ASSERT(writer.template serialize<predicted<uint32_t>>(quantized.b, predicted_quat.b, static_cast<uint32_t>(BitsPerElement)));
+			BS_ASSERT(writer.template serialize<predicted<uint32_t>>(quantized.c, predicted_quat.c, static_cast<uint32_t>(BitsPerElement)));
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads and dequantizes a quaternion as residuals from the @p reader
+		 * @param reader The stream to read from
+		 * @param value The quaternion to read into
+		 * @param prediction The predicted quaternion, which the writer must also have used
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& reader, Q& value, in<Q> prediction) noexcept
+		{
+			quantized_quaternion predicted_quat = smallest_three<Q, BitsPerElement>::quantize(prediction);
+			quantized_quaternion quantized;
+
+			uint32_t same;
+			BS_ASSERT(reader.serialize_bits(same, 1U));
+
+			if (same)
+			{
+				quantized.m = predicted_quat.m;
+			}
+			else
+			{
+				BS_ASSERT(reader.serialize_bits(quantized.m, 2U));
+			}
+
+			BS_ASSERT(reader.template serialize<predicted<uint32_t>>(quantized.a, predicted_quat.a, static_cast<uint32_t>(BitsPerElement)));
+			BS_ASSERT(reader.template serialize<predicted<uint32_t>>(quantized.b, predicted_quat.b, static_cast<uint32_t>(BitsPerElement)));
+			BS_ASSERT(reader.template serialize<predicted<uint32_t>>(quantized.c, predicted_quat.c, static_cast<uint32_t>(BitsPerElement)));
+
+			value = smallest_three<Q, BitsPerElement>::dequantize(quantized);
+
+			return true;
+		}
+	};
+}
\ No newline at end of file
@@ -1,17 +1,48 @@
 #pragma once
 #include "../quantization/bounded_range.h"
+#include "../quantization/bounded_range_d.h"
 #include "../quantization/half_precision.h"
+#include "../quantization/octahedral_normal.h"
 #include "../quantization/smallest_three.h"
 #include "../utility/assert.h"
+#include "../utility/bit_record.h"
 #include "../utility/meta.h"
 #include "../utility/parameter.h"
 
 #include "../stream/serialize_traits.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <ratio>
 
 namespace bitstream
 {
+	/**
+	 * @brief Wrapper type for a 3D vector quantized with a bounded_range per axis
+	*/
+	template<typename V>
+	struct bounded_vector3;
+
+	/**
+	 * @brief Wrapper type for a transform with a bounded position, a smallest-three rotation and an optional bounded scale
+	*/
+	template<typename V, typename Q, size_t BitsPerElement = 12>
+	struct quantized_transform;
+
+	/**
+	 * @brief Wrapper type for a bounded float with a range and precision known at compile time, given as std::ratio
+	*/
+	template<typename Min, typename Max, typename Precision>
+	struct bounded_ratio;
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+	/**
+	 * @brief Wrapper type for a bounded float with a range and precision known at compile time
+	*/
+	template<float Min, float Max, float Precision>
+	struct bounded_float;
+#endif // __cpp_nontype_template_args
+
 	/**
 	 * @brief A trait used to serialize a single-precision float as half-precision
 	*/
@@ -41,6 +72,76 @@ namespace bitstream
 
 			return true;
 		}
+
+		/**
+		 * @brief Quantizes and writes an array of floats as half-precision, packing 4 values into each 64-bit write
+		 * @param stream The stream to write to
+		 * @param values The values to write
+		 * @param count The number of values
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, const float* values, uint32_t count) noexcept
+		{
+			uint16_t quantized[batch_size];
+			for (uint32_t offset = 0U; offset < count; offset += batch_size)
+			{
+				uint32_t num_values = (std::min)(count - offset, batch_size);
+
+				half_precision::quantize(values + offset, quantized, num_values);
+
+				for (uint32_t i = 0U; i < num_values; i += 4U)
+				{
+					uint32_t num_word_values = (std::min)(num_values - i, 4U);
+
+					uint64_t word = 0U;
+					for (uint32_t j = 0U; j < num_word_values; j++)
+						word = (word << 16U) | quantized[i + j];
+
+					BS_ASSERT(stream.serialize_bits(word, num_word_values * 16U));
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads and dequantizes an array of half-precision floats
+		 * @param stream The stream to read from
+		 * @param values The array to read into
+		 * @param count The number of values
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, float* values, uint32_t count) noexcept
+		{
+			uint16_t quantized[batch_size];
+			for (uint32_t offset = 0U; offset < count; offset += batch_size)
+			{
+				uint32_t num_values = (std::min)(count - offset, batch_size);
+
+				for (uint32_t i = 0U; i < num_values; i += 4U)
+				{
+					uint32_t num_word_values = (std::min)(num_values - i, 4U);
+
+					uint64_t word;
+					BS_ASSERT(stream.serialize_bits(word, num_word_values * 16U));
+
+					for (uint32_t j = 0U; j < num_word_values; j++)
+						quantized[i + j] = static_cast<uint16_t>(word >> ((num_word_values - 1U - j) * 16U));
+				}
+
+				half_precision::dequantize(quantized, values + offset, num_values);
+			}
+
+			return true;
+		}
+
+	private:
+		// The number of values quantized at a time when serializing arrays
+		static constexpr uint32_t batch_size = 64U;
 	};
 
 	/**
@@ -72,8 +173,265 @@ namespace bitstream
 
 			return true;
 		}
+
+		/**
+		 * @brief Quantizes and writes an array of floats, packing as many values as fit into each 64-bit write
+		 * @param stream The stream to write to
+		 * @param range The range and precision of the values
+		 * @param values The values to write
+		 * @param count The number of values
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, in<bounded_range> range, const float* values, uint32_t count) noexcept
+		{
+			uint32_t bits_required = range.get_bits_required();
+
+			BS_ASSERT(bits_required > 0U);
+
+			uint32_t values_per_word = 64U / bits_required;
+
+			uint32_t quantized[batch_size];
+			for (uint32_t offset = 0U; offset < count; offset += batch_size)
+			{
+				uint32_t num_values = (std::min)(count - offset, batch_size);
+
+				range.quantize(values + offset, quantized, num_values);
+
+				for (uint32_t i = 0U; i < num_values; i += values_per_word)
+				{
+					uint32_t num_word_values = (std::min)(num_values - i, values_per_word);
+
+					uint64_t word = 0U;
+					for (uint32_t j = 0U; j < num_word_values; j++)
+						word = (word << bits_required) | quantized[i + j];
+
+					BS_ASSERT(stream.serialize_bits(word, num_word_values * bits_required));
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads and dequantizes an array of floats
+		 * @param stream The stream to read from
+		 * @param range The range and precision of the values
+		 * @param values The array to read into
+		 * @param count The number of values
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, in<bounded_range> range, float* values, uint32_t count) noexcept
+		{
+			uint32_t bits_required = range.get_bits_required();
+
+			BS_ASSERT(bits_required > 0U);
+
+			uint32_t values_per_word = 64U / bits_required;
+			uint64_t mask = (~0ULL) >> (64U - bits_required);
+
+			uint32_t quantized[batch_size];
+			for (uint32_t offset = 0U; offset < count; offset += batch_size)
+			{
+				uint32_t num_values = (std::min)(count - offset, batch_size);
+
+				for (uint32_t i = 0U; i < num_values; i += values_per_word)
+				{
+					uint32_t num_word_values = (std::min)(num_values - i, values_per_word);
+
+					uint64_t word;
+					BS_ASSERT(stream.serialize_bits(word, num_word_values * bits_required));
+
+					for (uint32_t j = 0U; j < num_word_values; j++)
+						quantized[i + j] = static_cast<uint32_t>((word >> ((num_word_values - 1U - j) * bits_required)) & mask);
+				}
+
+				range.dequantize(quantized, values + offset, num_values);
+			}
+
+			return true;
+		}
+
+	private:
+		// The number of values quantized at a time when serializing arrays
+		static constexpr uint32_t batch_size = 64U;
 	};
 
+	/**
+	 * @brief A trait used to quantize and serialize a double to be within a given range and precision, using up to 64 bits
+	*/
+	template<>
+	struct serialize_traits<bounded_range_d>
+	{
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, in<bounded_range_d> range, in<double> value) noexcept
+		{
+			uint64_t int_value = range.quantize(value);
+
+			BS_ASSERT(stream.serialize_bits(int_value, range.get_bits_required()));
+
+			return true;
+		}
+
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, in<bounded_range_d> range, out<double> value) noexcept
+		{
+			uint64_t int_value;
+
+			BS_ASSERT(stream.serialize_bits(int_value, range.get_bits_required()));
+
+			value = range.dequantize(int_value);
+
+			return true;
+		}
+	};
+
+	/**
+	 * @brief A trait used to quantize and serialize a float to be within a range and precision given as std::ratio.
+	 * The number of bits and the scale are known at compile time
+	*/
+	template<typename Min, typename Max, typename Precision>
+	struct serialize_traits<bounded_ratio<Min, Max, Precision>>
+	{
+		static_assert(std::ratio_less_v<Min, Max>);
+		static_assert(Precision::num > 0);
+
+		static constexpr bounded_range range
+		{
+			static_cast<float>(Min::num) / static_cast<float>(Min::den),
+			static_cast<float>(Max::num) / static_cast<float>(Max::den),
+			static_cast<float>(Precision::num) / static_cast<float>(Precision::den)
+		};
+
+		/**
+		 * @brief Quantizes and writes a float into the @p stream
+		 * @param stream The stream to write to
+		 * @param value The value to serialize
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, in<float> value) noexcept
+		{
+			return serialize_traits<bounded_range>::serialize(stream, range, value);
+		}
+
+		/**
+		 * @brief Reads and dequantizes a float from the @p stream
+		 * @param stream The stream to read from
+		 * @param value The value to read into
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, float& value) noexcept
+		{
+			return serialize_traits<bounded_range>::serialize(stream, range, value);
+		}
+
+		/**
+		 * @brief Quantizes and writes an array of floats into the @p stream
+		 * @param stream The stream to write to
+		 * @param values The values to serialize
+		 * @param count The number of values
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, const float* values, uint32_t count) noexcept
+		{
+			return serialize_traits<bounded_range>::serialize(stream, range, values, count);
+		}
+
+		/**
+		 * @brief Reads and dequantizes an array of floats from the @p stream
+		 * @param stream The stream to read from
+		 * @param values The array to read into
+		 * @param count The number of values
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, float* values, uint32_t count) noexcept
+		{
+			return serialize_traits<bounded_range>::serialize(stream, range, values, count);
+		}
+	};
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+	/**
+	 * @brief A trait used to quantize and serialize a float to be within a range and precision given as template parameters.
+	 * The number of bits and the scale are known at compile time
+	*/
+	template<float Min, float Max, float Precision>
+	struct serialize_traits<bounded_float<Min, Max, Precision>>
+	{
+		static_assert(Min < Max);
+		static_assert(Precision > 0.0f);
+
+		static constexpr bounded_range range{ Min, Max, Precision };
+
+		/**
+		 * @brief Quantizes and writes a float into the @p stream
+		 * @param stream The stream to write to
+		 * @param value The value to serialize
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, in<float> value) noexcept
+		{
+			return serialize_traits<bounded_range>::serialize(stream, range, value);
+		}
+
+		/**
+		 * @brief Reads and dequantizes a float from the @p stream
+		 * @param stream The stream to read from
+		 * @param value The value to read into
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, float& value) noexcept
+		{
+			return serialize_traits<bounded_range>::serialize(stream, range, value);
+		}
+
+		/**
+		 * @brief Quantizes and writes an array of floats into the @p stream
+		 * @param stream The stream to write to
+		 * @param values The values to serialize
+		 * @param count The number of values
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, const float* values, uint32_t count) noexcept
+		{
+			return serialize_traits<bounded_range>::serialize(stream, range, values, count);
+		}
+
+		/**
+		 * @brief Reads and dequantizes an array of floats from the @p stream
+		 * @param stream The stream to read from
+		 * @param values The array to read into
+		 * @param count The number of values
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, float* values, uint32_t count) noexcept
+		{
+			return serialize_traits<bounded_range>::serialize(stream, range, values, count);
+		}
+	};
+#endif // __cpp_nontype_template_args
+
 	/**
 	 * @brief A trait used to quantize and serialize quaternions using the smallest-three algorithm
 	*/
@@ -109,5 +467,439 @@ namespace bitstream
 
 			return true;
 		}
+
+		/**
+		 * @brief Quantizes and writes an array of quaternions, packing as many records as fit into each 64-bit write
+		 * @param stream The stream to write to
+		 * @param values The quaternions to write
+		 * @param count The number of quaternions
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, const Q* values, uint32_t count) noexcept
+		{
+			float components[4][batch_size];
+			uint32_t quantized[4][batch_size];
+			for (uint32_t offset = 0U; offset < count; offset += batch_size)
+			{
+				uint32_t num_values = (std::min)(count - offset, batch_size);
+
+				for (uint32_t i = 0U; i < num_values; i++)
+					for (uint32_t k = 0U; k < 4U; k++)
+						components[k][i] = values[offset + i][k];
+
+				smallest_three<Q, BitsPerElement>::quantize({ components[0], components[1], components[2], components[3] }, { quantized[0], quantized[1], quantized[2], quantized[3] }, num_values);
+
+				for (uint32_t i = 0U; i < num_values; i += records_per_word)
+				{
+					uint32_t num_records = (std::min)(num_values - i, records_per_word);
+
+					if constexpr (record_bits <= 64U)
+					{
+						uint64_t word = 0U;
+						for (uint32_t j = 0U; j < num_records; j++)
+						{
+							word = (word << 2U) | quantized[0][i + j];
+							for (uint32_t k = 1U; k < 4U; k++)
+								word = (word << BitsPerElement) | quantized[k][i + j];
+						}
+
+						BS_ASSERT(stream.serialize_bits(word, num_records * record_bits));
+					}
+					else
+					{
+						BS_ASSERT(stream.serialize_bits(quantized[0][i], 2));
+						for (uint32_t k = 1U; k < 4U; k++)
+							BS_ASSERT(stream.serialize_bits(quantized[k][i], BitsPerElement));
+					}
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads and dequantizes an array of quaternions
+		 * @param stream The stream to read from
+		 * @param values The array to read into
+		 * @param count The number of quaternions
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, Q* values, uint32_t count) noexcept
+		{
+			constexpr uint64_t element_mask = (1ULL << BitsPerElement) - 1U;
+
+			float components[4][batch_size];
+			uint32_t quantized[4][batch_size];
+			for (uint32_t offset = 0U; offset < count; offset += batch_size)
+			{
+				uint32_t num_values = (std::min)(count - offset, batch_size);
+
+				for (uint32_t i = 0U; i < num_values; i += records_per_word)
+				{
+					uint32_t num_records = (std::min)(num_values - i, records_per_word);
+
+					if constexpr (record_bits <= 64U)
+					{
+						uint64_t word;
+						BS_ASSERT(stream.serialize_bits(word, num_records * record_bits));
+
+						for (uint32_t j = num_records; j-- > 0U;)
+						{
+							for (uint32_t k = 4U; k-- > 1U;)
+							{
+								quantized[k][i + j] = static_cast<uint32_t>(word & element_mask);
+								word >>= BitsPerElement;
+							}
+
+							quantized[0][i + j] = static_cast<uint32_t>(word & 3U);
+							word >>= 2U;
+						}
+					}
+					else
+					{
+						BS_ASSERT(stream.serialize_bits(quantized[0][i], 2));
+						for (uint32_t k = 1U; k < 4U; k++)
+							BS_ASSERT(stream.serialize_bits(quantized[k][i], BitsPerElement));
+					}
+				}
+
+				smallest_three<Q, BitsPerElement>::dequantize({ quantized[0], quantized[1], quantized[2], quantized[3] }, { components[0], components[1], components[2], components[3] }, num_values);
+
+				for (uint32_t i = 0U; i < num_values; i++)
+					values[offset + i] = Q{ components[0][i], components[1][i], components[2][i], components[3][i] };
+			}
+
+			return true;
+		}
+
+	private:
+		// The number of bits in a single quaternion
+		static constexpr uint32_t record_bits = 2U + 3U * BitsPerElement;
+
+		// The number of quaternions packed into each write, if they fit in 64 bits
+		static constexpr uint32_t records_per_word = record_bits <= 64U ? 64U / record_bits : 1U;
+
+		// The number of quaternions quantized at a time when serializing arrays
+		static constexpr uint32_t batch_size = 64U;
+	};
+
+	/**
+	 * @brief A trait used to quantize and serialize unit vectors using octahedral mapping
+	*/
+	template<typename V, size_t BitsPerElement>
+	struct serialize_traits<octahedral_normal<V, BitsPerElement>>
+	{
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, in<V> value) noexcept
+		{
+			quantized_normal quantized = octahedral_normal<V, BitsPerElement>::quantize(value);
+
+			uint64_t word = (static_cast<uint64_t>(quantized.u) << BitsPerElement) | quantized.v;
+
+			BS_ASSERT(stream.serialize_bits(word, record_bits));
+
+			return true;
+		}
+
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, out<V> value) noexcept
+		{
+			uint64_t word;
+
+			BS_ASSERT(stream.serialize_bits(word, record_bits));
+
+			quantized_normal quantized;
+			quantized.u = static_cast<uint32_t>(word >> BitsPerElement);
+			quantized.v = static_cast<uint32_t>(word & element_mask);
+
+			value = octahedral_normal<V, BitsPerElement>::dequantize(quantized);
+
+			return true;
+		}
+
+		/**
+		 * @brief Quantizes and writes an array of unit vectors, packing as many as fit into each 64-bit write
+		 * @param stream The stream to write to
+		 * @param values The vectors to write
+		 * @param count The number of vectors
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, const V* values, uint32_t count) noexcept
+		{
+			float components[3][batch_size];
+			uint32_t quantized[2][batch_size];
+			for (uint32_t offset = 0U; offset < count; offset += batch_size)
+			{
+				uint32_t num_values = (std::min)(count - offset, batch_size);
+
+				for (uint32_t i = 0U; i < num_values; i++)
+					for (uint32_t k = 0U; k < 3U; k++)
+						components[k][i] = values[offset + i][k];
+
+				octahedral_normal<V, BitsPerElement>::quantize({ components[0], components[1], components[2] }, { quantized[0], quantized[1] }, num_values);
+
+				for (uint32_t i = 0U; i < num_values; i += records_per_word)
+				{
+					uint32_t num_records = (std::min)(num_values - i, records_per_word);
+
+					uint64_t word = 0U;
+					for (uint32_t j = 0U; j < num_records; j++)
+						word = (word << record_bits) | (static_cast<uint64_t>(quantized[0][i + j]) << BitsPerElement) | quantized[1][i + j];
+
+					BS_ASSERT(stream.serialize_bits(word, num_records * record_bits));
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads and dequantizes an array of unit vectors
+		 * @param stream The stream to read from
+		 * @param values The array to read into
+		 * @param count The number of vectors
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, V* values, uint32_t count) noexcept
+		{
+			float components[3][batch_size];
+			uint32_t quantized[2][batch_size];
+			for (uint32_t offset = 0U; offset < count; offset += batch_size)
+			{
+				uint32_t num_values = (std::min)(count - offset, batch_size);
+
+				for (uint32_t i = 0U; i < num_values; i += records_per_word)
+				{
+					uint32_t num_records = (std::min)(num_values - i, records_per_word);
+
+					uint64_t word;
+					BS_ASSERT(stream.serialize_bits(word, num_records * record_bits));
+
+					for (uint32_t j = num_records; j-- > 0U;)
+					{
+						quantized[1][i + j] = static_cast<uint32_t>(word & element_mask);
+						quantized[0][i + j] = static_cast<uint32_t>((word >> BitsPerElement) & element_mask);
+						word >>= record_bits;
+					}
+				}
+
+				octahedral_normal<V, BitsPerElement>::dequantize({ quantized[0], quantized[1] }, { components[0], components[1], components[2] }, num_values);
+
+				for (uint32_t i = 0U; i < num_values; i++)
+					values[offset + i] = V{ components[0][i], components[1][i], components[2][i] };
+			}
+
+			return true;
+		}
+
+	private:
+		static constexpr uint64_t element_mask = (1ULL << BitsPerElement) - 1U;
+
+		// The number of bits in a single vector
+		static constexpr uint32_t record_bits = 2U * BitsPerElement;
+
+		// The number of vectors packed into each write
+		static constexpr uint32_t records_per_word = 64U / record_bits;
+
+		// The number of vectors quantized at a time when serializing arrays
+		static constexpr uint32_t batch_size = 64U;
+	};
+
+	/**
+	 * @brief A trait used to quantize and serialize a 3D vector as a single record, with a bounded_range per axis
+	*/
+	template<typename V>
+	struct serialize_traits<bounded_vector3<V>>
+	{
+		/**
+		 * @brief Quantizes and writes a vector into the @p stream
+		 * @param stream The stream to write to
+		 * @param ranges The range and precision of each axis
+		 * @param value The vector to serialize
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, const bounded_range (&ranges)[3], in<V> value) noexcept
+		{
+			utility::bit_record<96U> record;
+			for (uint32_t i = 0U; i < 3U; i++)
+				record.append(ranges[i].quantize(value[i]), ranges[i].get_bits_required());
+
+			return record.write(stream);
+		}
+
+		/**
+		 * @brief Reads and dequantizes a vector from the @p stream
+		 * @param stream The stream to read from
+		 * @param ranges The range and precision of each axis
+		 * @param value The vector to read into
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, const bounded_range (&ranges)[3], V& value) noexcept
+		{
+			utility::bit_record<96U> record;
+			BS_ASSERT(record.read(stream, ranges[0].get_bits_required() + ranges[1].get_bits_required() + ranges[2].get_bits_required()));
+
+			float x = ranges[0].dequantize(static_cast<uint32_t>(record.extract(ranges[0].get_bits_required())));
+			float y = ranges[1].dequantize(static_cast<uint32_t>(record.extract(ranges[1].get_bits_required())));
+			float z = ranges[2].dequantize(static_cast<uint32_t>(record.extract(ranges[2].get_bits_required())));
+
+			value = V{ x, y, z };
+
+			return true;
+		}
+	};
+
+	/**
+	 * @brief A trait used to quantize and serialize a transform as a single record.
+	 * The position and optional scale use a bounded_range per axis, while the rotation uses smallest_three
+	*/
+	template<typename V, typename Q, size_t BitsPerElement>
+	struct serialize_traits<quantized_transform<V, Q, BitsPerElement>>
+	{
+		/**
+		 * @brief Quantizes and writes a transform without scale into the @p stream
+		 * @param stream The stream to write to
+		 * @param position_ranges The range and precision of each axis of the position
+		 * @param position The position to serialize
+		 * @param rotation The rotation to serialize
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, const bounded_range (&position_ranges)[3], in<V> position, in<Q> rotation) noexcept
+		{
+			record_type record;
+			append_vector(record, position_ranges, position);
+			append_rotation(record, rotation);
+
+			return record.write(stream);
+		}
+
+		/**
+		 * @brief Reads and dequantizes a transform without scale from the @p stream
+		 * @param stream The stream to read from
+		 * @param position_ranges The range and precision of each axis of the position
+		 * @param position The position to read into
+		 * @param rotation The rotation to read into
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, const bounded_range (&position_ranges)[3], V& position, Q& rotation) noexcept
+		{
+			record_type record;
+			BS_ASSERT(record.read(stream, get_vector_bits(position_ranges) + rotation_bits));
+
+			position = extract_vector(record, position_ranges);
+			rotation = extract_rotation(record);
+
+			return true;
+		}
+
+		/**
+		 * @brief Quantizes and writes a transform with scale into the @p stream
+		 * @param stream The stream to write to
+		 * @param position_ranges The range and precision of each axis of the position
+		 * @param position The position to serialize
+		 * @param rotation The rotation to serialize
+		 * @param scale_ranges The range and precision of each axis of the scale
+		 * @param scale The scale to serialize
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_writing_t<Stream>
+		static serialize(Stream& stream, const bounded_range (&position_ranges)[3], in<V> position, in<Q> rotation, const bounded_range (&scale_ranges)[3], in<V> scale) noexcept
+		{
+			record_type record;
+			append_vector(record, position_ranges, position);
+			append_rotation(record, rotation);
+			append_vector(record, scale_ranges, scale);
+
+			return record.write(stream);
+		}
+
+		/**
+		 * @brief Reads and dequantizes a transform with scale from the @p stream
+		 * @param stream The stream to read from
+		 * @param position_ranges The range and precision of each axis of the position
+		 * @param position The position to read into
+		 * @param rotation The rotation to read into
+		 * @param scale_ranges The range and precision of each axis of the scale
+		 * @param scale The scale to read into
+		 * @return Success
+		*/
+		template<typename Stream>
+		typename utility::is_reading_t<Stream>
+		static serialize(Stream& stream, const bounded_range (&position_ranges)[3], V& position, Q& rotation, const bounded_range (&scale_ranges)[3], V& scale) noexcept
+		{
+			record_type record;
+			BS_ASSERT(record.read(stream, get_vector_bits(position_ranges) + rotation_bits + get_vector_bits(scale_ranges)));
+
+			position = extract_vector(record, position_ranges);
+			rotation = extract_rotation(record);
+			scale = extract_vector(record, scale_ranges);
+
+			return true;
+		}
+
+	private:
+		static constexpr uint32_t rotation_bits = 2U + 3U * BitsPerElement;
+
+		using record_type = utility::bit_record<96U + rotation_bits + 96U>;
+
+		static uint32_t get_vector_bits(const bounded_range (&ranges)[3]) noexcept
+		{
+			return ranges[0].get_bits_required() + ranges[1].get_bits_required() + ranges[2].get_bits_required();
+		}
+
+		static void append_vector(record_type& record, const bounded_range (&ranges)[3], in<V> value) noexcept
+		{
+			for (uint32_t i = 0U; i < 3U; i++)
+				record.append(ranges[i].quantize(value[i]), ranges[i].get_bits_required());
+		}
+
+		static void append_rotation(record_type& record, in<Q> rotation) noexcept
+		{
+			quantized_quaternion quantized_quat = smallest_three<Q, BitsPerElement>::quantize(rotation);
+
+			record.append(quantized_quat.m, 2U);
+			record.append(quantized_quat.a, BitsPerElement);
+			record.append(quantized_quat.b, BitsPerElement);
+			record.append(quantized_quat.c, BitsPerElement);
+		}
+
+		static V extract_vector(record_type& record, const bounded_range (&ranges)[3]) noexcept
+		{
+			float x = ranges[0].dequantize(static_cast<uint32_t>(record.extract(ranges[0].get_bits_required())));
+			float y = ranges[1].dequantize(static_cast<uint32_t>(record.extract(ranges[1].get_bits_required())));
+			float z = ranges[2].dequantize(static_cast<uint32_t>(record.extract(ranges[2].get_bits_required())));
+
+			return V{ x, y, z };
+		}
+
+		static Q extract_rotation(record_type& record) noexcept
+		{
+			quantized_quaternion quantized_quat;
+			quantized_quat.m = static_cast<uint32_t>(record.extract(2U));
+			quantized_quat.a = static_cast<uint32_t>(record.extract(BitsPerElement));
+			quantized_quat.b = static_cast<uint32_t>(record.extract(BitsPerElement));
+			quantized_quat.c = static_cast<uint32_t>(record.extract(BitsPerElement));
+
+			return smallest_three<Q, BitsPerElement>::dequantize(quantized_quat);
+		}
 	};
 }
\ No newline at end of file
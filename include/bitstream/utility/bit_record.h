@@ -0,0 +1,119 @@
+#pragma once
+#include "assert.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bitstream::utility
+{
+	/**
+	 * @brief A fixed-capacity sequence of bit fields, which is serialized 64 bits at a time.
+	 * Appending fields and writing the record gives the same result as serializing each field separately
+	 * @tparam MaxBits The maximum number of bits in the record
+	*/
+	template<size_t MaxBits>
+	class bit_record
+	{
+	public:
+		static constexpr size_t max_words = (MaxBits + 63U) / 64U;
+
+		/**
+		 * @brief Appends a field to the end of the record
+		 * @param value The value of the field. Bits above @p num_bits are ignored
+		 * @param num_bits The number of bits in the field, between 1 and 64
+		*/
+		constexpr void append(uint64_t value, uint32_t num_bits) noexcept
+		{
+			value &= ~0ULL >> (64U - num_bits);
+
+			uint32_t word_index = m_NumBits / 64U;
+			uint32_t free_bits = 64U - m_NumBits % 64U;
+
+			if (num_bits <= free_bits)
+			{
+				m_Words[word_index] |= value << (free_bits - num_bits);
+			}
+			else
+			{
+				m_Words[word_index] |= value >> (num_bits - free_bits);
+				m_Words[word_index + 1U] = value << (64U - (num_bits - free_bits));
+			}
+
+			m_NumBits += num_bits;
+		}
+
+		/**
+		 * @brief Removes the next field from the start of a record that has been read
+		 * @param num_bits The number of bits in the field, between 1 and 64
+		 * @return The value of the field
+		*/
+		constexpr uint64_t extract(uint32_t num_bits) noexcept
+		{
+			uint32_t word_index = m_ReadBits / 64U;
+			uint32_t used_bits = m_ReadBits % 64U;
+
+			uint64_t value = m_Words[word_index] << used_bits;
+			if (used_bits + num_bits > 64U)
+				value |= m_Words[word_index + 1U] >> (64U - used_bits);
+
+			m_ReadBits += num_bits;
+
+			return value >> (64U - num_bits);
+		}
+
+		/**
+		 * @brief Writes the record into the @p writer, using one write per 64 bits
+		 * @param writer The stream to write to
+		 * @return Success
+		*/
+		template<typename Stream>
+		bool write(Stream& writer) const noexcept
+		{
+			uint32_t num_words = m_NumBits / 64U;
+			for (uint32_t i = 0U; i < num_words; i++)
+				BS_ASSERT(writer.serialize_bits(m_Words[i], 64U));
+
+			uint32_t remaining_bits = m_NumBits % 64U;
+			if (remaining_bits > 0U)
+				BS_ASSERT(writer.serialize_bits(m_Words[num_words] >> (64U - remaining_bits), remaining_bits));
+
+			return true;
+		}
+
+		/**
+		 * @brief Reads a record from the @p reader, using one read per 64 bits
+		 * @param reader The stream to read from
+		 * @param num_bits The total number of bits in the record
+		 * @return Success
+		*/
+		template<typename Stream>
+		bool read(Stream& reader, uint32_t num_bits) noexcept
+		{
+			BS_ASSERT(num_bits <= MaxBits);
+
+			uint32_t num_words = num_bits / 64U;
+			for (uint32_t i = 0U; i < num_words; i++)
+				BS_ASSERT(reader.serialize_bits(m_Words[i], 64U));
+
+			uint32_t remaining_bits = num_bits % 64U;
+			if (remaining_bits > 0U)
+			{
+				BS_ASSERT(reader.serialize_bits(m_Words[num_words], remaining_bits));
+
+				m_Words[num_words] <<= 64U - remaining_bits;
+			}
+
+			m_NumBits = num_bits;
+			m_ReadBits = 0U;
+
+			return true;
+		}
+
+		constexpr uint32_t get_num_bits() const noexcept { return m_NumBits; }
+
+	private:
+		uint64_t m_Words[max_words]{};
+		uint32_t m_NumBits = 0U;
+		uint32_t m_ReadBits = 0U;
+	};
+}
\ No newline at end of file
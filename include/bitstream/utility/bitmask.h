@@ -0,0 +1,139 @@
+#pragma once
+
+#include "platform.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef BS_SSE2
+#include <emmintrin.h>
+#endif // BS_SSE2
+
+namespace bitstream::utility
+{
+	/**
+	 * @brief Packs an array of flags into 64-bit words, where bit i % 64 of word i / 64 is set if flag i is nonzero
+	 * @param flags The flags to pack
+	 * @param count The number of flags
+	 * @param words The words to pack into. Must hold at least (count + 63) / 64 words
+	*/
+	inline void pack_flags(const uint8_t* flags, size_t count, uint64_t* words) noexcept
+	{
+		for (size_t offset = 0U; offset < count; offset += 64U)
+		{
+			size_t num_flags = count - offset < 64U ? count - offset : 64U;
+			const uint8_t* word_flags = flags + offset;
+
+			uint64_t word = 0U;
+			size_t i = 0U;
+#ifdef BS_SSE2
+			// 16 flags at a time, using the sign bits of a byte comparison
+			const __m128i zero = _mm_setzero_si128();
+			for (; i + 16U <= num_flags; i += 16U)
+			{
+				__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(word_flags + i));
+				uint32_t zeros = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(values, zero)));
+
+				word |= static_cast<uint64_t>(~zeros & 0xFFFFU) << i;
+			}
+#endif // BS_SSE2
+			for (; i < num_flags; i++)
+				word |= static_cast<uint64_t>(word_flags[i] != 0U) << i;
+
+			words[offset / 64U] = word;
+		}
+	}
+
+	/**
+	 * @brief Packs an array of bools into 64-bit words, where bit i % 64 of word i / 64 is set if bool i is true
+	 * @param flags The bools to pack
+	 * @param count The number of bools
+	 * @param words The words to pack into. Must hold at least (count + 63) / 64 words
+	*/
+	inline void pack_flags(const bool* flags, size_t count, uint64_t* words) noexcept
+	{
+		pack_flags(reinterpret_cast<const uint8_t*>(flags), count, words);
+	}
+
+	/**
+	 * @brief Unpacks 64-bit words into an array of flags, where flag i is set to 1 if bit i % 64 of word i / 64 is set, or 0 otherwise
+	 * @param words The words to unpack
+	 * @param count The number of flags
+	 * @param flags The flags to unpack into
+	*/
+	inline void unpack_flags(const uint64_t* words, size_t count, uint8_t* flags) noexcept
+	{
+		for (size_t offset = 0U; offset < count; offset += 64U)
+		{
+			size_t num_flags = count - offset < 64U ? count - offset : 64U;
+			uint8_t* word_flags = flags + offset;
+			uint64_t word = words[offset / 64U];
+
+			size_t i = 0U;
+#ifdef BS_SSE2
+			// 16 flags at a time, by spreading each byte of the word over 8 bytes and testing a different bit in each
+			const __m128i bit_masks = _mm_set_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+			const __m128i ones = _mm_set1_epi8(1);
+			for (; i + 16U <= num_flags; i += 16U)
+			{
+				char low = static_cast<char>(word >> i);
+				char high = static_cast<char>(word >> (i + 8U));
+
+				__m128i bytes = _mm_unpacklo_epi64(_mm_set1_epi8(low), _mm_set1_epi8(high));
+				__m128i set = _mm_cmpeq_epi8(_mm_and_si128(bytes, bit_masks), bit_masks);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(word_flags + i), _mm_and_si128(set, ones));
+			}
+#endif // BS_SSE2
+			for (; i < num_flags; i++)
+				word_flags[i] = static_cast<uint8_t>((word >> i) & 1U);
+		}
+	}
+
+	/**
+	 * @brief Unpacks 64-bit words into an array of bools, where bool i is true if bit i % 64 of word i / 64 is set
+	 * @param words The words to unpack
+	 * @param count The number of bools
+	 * @param flags The bools to unpack into
+	*/
+	inline void unpack_flags(const uint64_t* words, size_t count, bool* flags) noexcept
+	{
+		unpack_flags(words, count, reinterpret_cast<uint8_t*>(flags));
+	}
+
+	/**
+	 * @brief Packs the differences between two arrays into 64-bit words, where bit i % 64 of word i / 64 is set if the values at index i differ.
+	 * Useful for comparing per-object version counters against the ones that were last sent
+	 * @param current The current values
+	 * @param previous The values to compare against
+	 * @param count The number of values in each array
+	 * @param words The words to pack into. Must hold at least (count + 63) / 64 words
+	*/
+	inline void pack_not_equal(const uint32_t* current, const uint32_t* previous, size_t count, uint64_t* words) noexcept
+	{
+		for (size_t offset = 0U; offset < count; offset += 64U)
+		{
+			size_t num_values = count - offset < 64U ? count - offset : 64U;
+			const uint32_t* word_current = current + offset;
+			const uint32_t* word_previous = previous + offset;
+
+			uint64_t word = 0U;
+			size_t i = 0U;
+#ifdef BS_SSE2
+			// 4 values at a time, using the sign bits of a 32-bit comparison
+			for (; i + 4U <= num_values; i += 4U)
+			{
+				__m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(word_current + i));
+				__m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(word_previous + i));
+				uint32_t equal = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lhs, rhs))));
+
+				word |= static_cast<uint64_t>(~equal & 0xFU) << i;
+			}
+#endif // BS_SSE2
+			for (; i < num_values; i++)
+				word |= static_cast<uint64_t>(word_current[i] != word_previous[i]) << i;
+
+			words[offset / 64U] = word;
+		}
+	}
+}
@@ -3,6 +3,14 @@
 #include <cstddef>
 #include <cstdint>
 
+#if __has_include(<bit>)
+#include <bit>
+#endif
+
+#if defined(_WIN32)
+#include <intrin.h>
+#endif
+
 namespace bitstream::utility
 {
 	constexpr inline uint32_t bits_to_represent(uintmax_t n)
@@ -23,4 +31,91 @@ namespace bitstream::utility
 	{
 		return bits_to_represent(static_cast<uintmax_t>(max) - static_cast<uintmax_t>(min));
 	}
+
+	constexpr inline uint32_t count_leading_zeros64_const(uint64_t value)
+	{
+		if (value == 0U)
+			return 64U;
+
+		return 64U - bits_to_represent(value);
+	}
+
+	constexpr inline uint32_t popcount64_const(uint64_t value)
+	{
+		value = value - ((value >> 1U) & 0x5555555555555555ULL);
+		value = (value & 0x3333333333333333ULL) + ((value >> 2U) & 0x3333333333333333ULL);
+		value = (value + (value >> 4U)) & 0x0F0F0F0F0F0F0F0FULL;
+
+		return static_cast<uint32_t>((value * 0x0101010101010101ULL) >> 56U);
+	}
+
+	inline uint32_t count_leading_zeros64(uint64_t value)
+	{
+#if defined(__cpp_lib_bitops) && __cpp_lib_bitops >= 201907L
+		return static_cast<uint32_t>(std::countl_zero(value));
+#elif defined(__GNUC__) || defined(__clang__)
+		return value == 0U ? 64U : static_cast<uint32_t>(__builtin_clzll(value));
+#elif defined(_WIN32)
+		unsigned long index;
+		if (_BitScanReverse(&index, static_cast<unsigned long>(value >> 32U)))
+			return 31U - static_cast<uint32_t>(index);
+		if (_BitScanReverse(&index, static_cast<unsigned long>(value)))
+			return 63U - static_cast<uint32_t>(index);
+		return 64U;
+#else
+		return count_leading_zeros64_const(value);
+#endif
+	}
+
+	constexpr inline uint32_t count_trailing_zeros64_const(uint64_t value)
+	{
+		if (value == 0U)
+			return 64U;
+
+		return popcount64_const((value & (~value + 1U)) - 1U);
+	}
+
+	constexpr inline uint32_t reverse_bits32(uint32_t value)
+	{
+		value = ((value >> 1U) & 0x55555555U) | ((value & 0x55555555U) << 1U);
+		value = ((value >> 2U) & 0x33333333U) | ((value & 0x33333333U) << 2U);
+		value = ((value >> 4U) & 0x0F0F0F0FU) | ((value & 0x0F0F0F0FU) << 4U);
+		value = ((value >> 8U) & 0x00FF00FFU) | ((value & 0x00FF00FFU) << 8U);
+
+		return (value >> 16U) | (value << 16U);
+	}
+
+	constexpr inline uint64_t reverse_bits64(uint64_t value)
+	{
+		return (static_cast<uint64_t>(reverse_bits32(static_cast<uint32_t>(value))) << 32U) | reverse_bits32(static_cast<uint32_t>(value >> 32U));
+	}
+
+	inline uint32_t count_trailing_zeros64(uint64_t value)
+	{
+#if defined(__cpp_lib_bitops) && __cpp_lib_bitops >= 201907L
+		return static_cast<uint32_t>(std::countr_zero(value));
+#elif defined(__GNUC__) || defined(__clang__)
+		return value == 0U ? 64U : static_cast<uint32_t>(__builtin_ctzll(value));
+#elif defined(_WIN32)
+		unsigned long index;
+		if (_BitScanForward(&index, static_cast<unsigned long>(value)))
+			return static_cast<uint32_t>(index);
+		if (_BitScanForward(&index, static_cast<unsigned long>(value >> 32U)))
+			return 32U + static_cast<uint32_t>(index);
+		return 64U;
+#else
+		return count_trailing_zeros64_const(value);
+#endif
+	}
+
+	inline uint32_t popcount64(uint64_t value)
+	{
+#if defined(__cpp_lib_bitops) && __cpp_lib_bitops >= 201907L
+		return static_cast<uint32_t>(std::popcount(value));
+#elif defined(__GNUC__) || defined(__clang__)
+		return static_cast<uint32_t>(__builtin_popcountll(value));
+#else
+		return popcount64_const(value);
+#endif
+	}
 }
\ No newline at end of file
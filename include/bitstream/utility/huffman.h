@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bitstream::utility
+{
+	/**
+	 * @brief A canonical Huffman code, with the tables needed for both encoding and decoding
+	 * @tparam NumSymbols The number of symbols in the alphabet
+	*/
+	template<size_t NumSymbols>
+	struct huffman_code
+	{
+		static_assert(NumSymbols > 0U && NumSymbols <= 0xFFFFU, "The number of symbols must be within [1, 65535]");
+
+		// Codes longer than this are shortened, so a code always fits within a single read
+		static constexpr uint32_t max_code_length = 24U;
+
+		// Codes up to this length are decoded with a single table lookup
+		static constexpr uint32_t lookup_bits = 8U;
+
+		uint32_t codes[NumSymbols];
+		uint32_t lengths[NumSymbols];
+		uint32_t max_length;
+
+		uint16_t sorted_symbols[NumSymbols];
+		uint32_t first_code[max_code_length + 1U];
+		uint32_t first_index[max_code_length + 1U];
+		uint32_t counts[max_code_length + 1U];
+
+		uint16_t lookup_symbols[1U << lookup_bits];
+		uint8_t lookup_lengths[1U << lookup_bits];
+
+		/**
+		 * @brief Decodes the symbol at the start of @p window
+		 * @param window The next max_length bits of the stream
+		 * @param symbol The decoded symbol
+		 * @param length The length of the code for the decoded symbol
+		 * @return Whether the window started with a valid code
+		*/
+		constexpr bool decode(uint32_t window, uint32_t& symbol, uint32_t& length) const noexcept
+		{
+			uint32_t table_bits = max_length < lookup_bits ? max_length : lookup_bits;
+
+			uint32_t index = window >> (max_length - table_bits);
+			if (lookup_lengths[index] > 0U)
+			{
+				symbol = lookup_symbols[index];
+				length = lookup_lengths[index];
+				return true;
+			}
+
+			// Codes longer than the lookup table are found by their canonical ranges
+			for (uint32_t len = table_bits + 1U; len <= max_length; len++)
+			{
+				uint32_t offset = (window >> (max_length - len)) - first_code[len];
+				if (offset < counts[len])
+				{
+					symbol = sorted_symbols[first_index[len] + offset];
+					length = len;
+					return true;
+				}
+			}
+
+			return false;
+		}
+	};
+
+	/**
+	 * @brief Builds a length-limited canonical Huffman code from the given frequencies
+	 * @tparam NumSymbols The number of symbols in the alphabet
+	 * @param frequencies The frequency of each symbol. Symbols with a frequency of 0 are not given a code
+	 * @return The canonical Huffman code
+	*/
+	template<size_t NumSymbols>
+	constexpr huffman_code<NumSymbols> make_huffman_code(const uint32_t (&frequencies)[NumSymbols]) noexcept
+	{
+		constexpr uint32_t max_code_length = huffman_code<NumSymbols>::max_code_length;
+		constexpr uint32_t lookup_bits = huffman_code<NumSymbols>::lookup_bits;
+
+		huffman_code<NumSymbols> code{};
+
+		// Build the tree, with leaves first and internal nodes after
+		uint64_t weights[NumSymbols * 2U]{};
+		size_t parents[NumSymbols * 2U]{};
+		bool active[NumSymbols * 2U]{};
+
+		size_t num_active = 0U;
+		for (size_t i = 0U; i < NumSymbols; i++)
+		{
+			weights[i] = frequencies[i];
+			parents[i] = NumSymbols * 2U;
+			active[i] = frequencies[i] > 0U;
+			num_active += active[i] ? 1U : 0U;
+		}
+
+		size_t num_nodes = NumSymbols;
+		for (size_t merges = 1U; merges < num_active; merges++)
+		{
+			size_t first = NumSymbols * 2U;
+			size_t second = NumSymbols * 2U;
+			for (size_t i = 0U; i < num_nodes; i++)
+			{
+				if (!active[i])
+					continue;
+
+				if (first == NumSymbols * 2U || weights[i] < weights[first])
+				{
+					second = first;
+					first = i;
+				}
+				else if (second == NumSymbols * 2U || weights[i] < weights[second])
+				{
+					second = i;
+				}
+			}
+
+			weights[num_nodes] = weights[first] + weights[second];
+			parents[num_nodes] = NumSymbols * 2U;
+			active[num_nodes] = true;
+			parents[first] = num_nodes;
+			parents[second] = num_nodes;
+			active[first] = false;
+			active[second] = false;
+			num_nodes++;
+		}
+
+		// The length of each code is the depth of its leaf, but a lone symbol still needs a bit
+		for (size_t i = 0U; i < NumSymbols; i++)
+		{
+			if (frequencies[i] == 0U)
+				continue;
+
+			uint32_t length = 0U;
+			for (size_t node = i; parents[node] != NumSymbols * 2U; node = parents[node])
+				length++;
+
+			code.lengths[i] = length > 0U ? length : 1U;
+		}
+
+		// Shorten any codes that are too long, then lengthen the longest remaining codes until the code is prefix-free again
+		uint64_t kraft_sum = 0U;
+		for (size_t i = 0U; i < NumSymbols; i++)
+		{
+			if (code.lengths[i] > max_code_length)
+				code.lengths[i] = max_code_length;
+
+			if (code.lengths[i] > 0U)
+				kraft_sum += 1ULL << (max_code_length - code.lengths[i]);
+		}
+
+		while (kraft_sum > (1ULL << max_code_length))
+		{
+			size_t longest = NumSymbols;
+			for (size_t i = 0U; i < NumSymbols; i++)
+			{
+				if (code.lengths[i] > 0U && code.lengths[i] < max_code_length && (longest == NumSymbols || code.lengths[i] > code.lengths[longest]))
+					longest = i;
+			}
+
+			kraft_sum -= 1ULL << (max_code_length - code.lengths[longest] - 1U);
+			code.lengths[longest]++;
+		}
+
+		// Sort the symbols by their length and assign consecutive codes within each length
+		for (size_t i = 0U; i < NumSymbols; i++)
+		{
+			code.counts[code.lengths[i]]++;
+
+			if (code.lengths[i] > code.max_length)
+				code.max_length = code.lengths[i];
+		}
+
+		code.counts[0] = 0U;
+
+		uint32_t next_code = 0U;
+		uint32_t next_index = 0U;
+		for (uint32_t len = 1U; len <= max_code_length; len++)
+		{
+			code.first_code[len] = next_code;
+			code.first_index[len] = next_index;
+
+			next_code = (next_code + code.counts[len]) << 1U;
+			next_index += code.counts[len];
+		}
+
+		uint32_t offsets[max_code_length + 1U]{};
+		for (size_t i = 0U; i < NumSymbols; i++)
+		{
+			uint32_t len = code.lengths[i];
+			if (len == 0U)
+				continue;
+
+			code.sorted_symbols[code.first_index[len] + offsets[len]] = static_cast<uint16_t>(i);
+			code.codes[i] = code.first_code[len] + offsets[len];
+			offsets[len]++;
+		}
+
+		// Fill the lookup table with every code that fits within it
+		uint32_t table_bits = code.max_length < lookup_bits ? code.max_length : lookup_bits;
+		for (size_t i = 0U; i < NumSymbols; i++)
+		{
+			uint32_t len = code.lengths[i];
+			if (len == 0U || len > table_bits)
+				continue;
+
+			uint32_t start = code.codes[i] << (table_bits - len);
+			uint32_t count = 1U << (table_bits - len);
+			for (uint32_t j = 0U; j < count; j++)
+			{
+				code.lookup_symbols[start + j] = static_cast<uint16_t>(i);
+				code.lookup_lengths[start + j] = static_cast<uint8_t>(len);
+			}
+		}
+
+		return code;
+	}
+}
@@ -2,6 +2,8 @@
 
 #include "../stream/serialize_traits.h"
 
+#include "platform.h"
+
 #include <type_traits>
 
 namespace bitstream::utility
@@ -20,6 +22,28 @@ namespace bitstream::utility
 	constexpr bool has_serialize_v = has_serialize<void, T, Stream, Args...>::value;
 
 
+	// Check if a trait can serialize the difference from a baseline itself
+	template<typename Void, typename T, typename Stream, typename... Args>
+	struct has_serialize_delta : std::false_type {};
+
+	template<typename T, typename Stream, typename... Args>
+	struct has_serialize_delta<std::void_t<decltype(serialize_traits<T>::serialize_delta(std::declval<Stream&>(), std::declval<Args>()...))>, T, Stream, Args...> : std::true_type {};
+
+	template<typename T, typename Stream, typename... Args>
+	constexpr bool has_serialize_delta_v = has_serialize_delta<void, T, Stream, Args...>::value;
+
+
+	// Check if a stream's policy can return its buffer as a single array, which segmented streams can't
+	template<typename Void, typename Stream>
+	struct has_buffer : std::false_type {};
+
+	template<typename Stream>
+	struct has_buffer<std::void_t<decltype(std::declval<const typename Stream::policy_type&>().get_buffer())>, Stream> : std::true_type {};
+
+	template<typename Stream>
+	constexpr bool has_buffer_v = has_buffer<void, Stream>::value;
+
+
 	// Check if stream is writing or reading
 	template<typename T, typename R = bool>
 	using is_writing_t = std::enable_if_t<T::writing, R>;
@@ -40,6 +64,34 @@ namespace bitstream::utility
 	constexpr bool is_serialize_noexcept_v = is_serialize_noexcept<void, T, Stream, Args...>::value;
 
 
+	// Integral type traits which also cover 128-bit integers, if the compiler supports them
+	template<typename T>
+	struct is_integral : std::is_integral<T> {};
+
+	template<typename T>
+	struct make_unsigned : std::make_unsigned<T> {};
+
+#ifdef BS_HAS_INT128
+	template<>
+	struct is_integral<__int128> : std::true_type {};
+
+	template<>
+	struct is_integral<unsigned __int128> : std::true_type {};
+
+	template<>
+	struct make_unsigned<__int128> { using type = unsigned __int128; };
+
+	template<>
+	struct make_unsigned<unsigned __int128> { using type = unsigned __int128; };
+#endif // BS_HAS_INT128
+
+	template<typename T>
+	constexpr bool is_integral_v = is_integral<T>::value;
+
+	template<typename T>
+	using make_unsigned_t = typename make_unsigned<T>::type;
+
+
 	// Get the underlying type without &, &&, * or const
 	template<typename T>
 	using base_t = typename std::remove_const_t<std::remove_pointer_t<std::decay_t<T>>>;
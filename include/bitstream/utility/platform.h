@@ -8,4 +8,33 @@
 #else // __cpp_lib_is_constant_evaluated
 #	define BS_CONST_EVALUATED() constexpr (false)
 #	define BS_CONSTEXPR
-#endif // __cpp_lib_is_constant_evaluated
\ No newline at end of file
+#endif // __cpp_lib_is_constant_evaluated
+
+#if defined(__SIZEOF_INT128__)
+#	define BS_HAS_INT128
+#endif // __SIZEOF_INT128__
+
+#if !defined(BS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#	define BS_SSE2
+#endif // BS_NO_SIMD
+
+#if !defined(BS_NO_SIMD) && defined(__AVX2__)
+#	define BS_AVX2
+#endif // BS_NO_SIMD
+
+#if !defined(BS_NO_SIMD) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#	define BS_F16C
+#endif // BS_NO_SIMD
+
+#if !defined(BS_NO_SIMD) && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#	define BS_FMA
+#endif // BS_NO_SIMD
+
+#if defined(__has_include)
+#	if __has_include(<memory_resource>)
+#		define BS_HAS_MEMORY_RESOURCE
+#	endif // __has_include
+#	if __has_include(<sys/uio.h>)
+#		define BS_HAS_IOVEC
+#	endif // __has_include
+#endif // __has_include
\ No newline at end of file
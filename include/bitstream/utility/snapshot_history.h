@@ -0,0 +1,168 @@
+#pragma once
+#include "bits.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bitstream::utility
+{
+	/**
+	 * @brief Returns whether the 16-bit sequence number @p lhs is newer than @p rhs, taking wrap-around into account
+	 * @param lhs The sequence number to compare
+	 * @param rhs The sequence number to compare against
+	 * @return Whether @p lhs is newer
+	*/
+	constexpr inline bool sequence_greater_than(uint16_t lhs, uint16_t rhs) noexcept
+	{
+		return static_cast<uint16_t>(lhs - rhs) != 0U && static_cast<uint16_t>(lhs - rhs) < 0x8000U;
+	}
+
+	/**
+	 * @brief A ring of the last @p N snapshots sent to a single client, indexed by sequence number.
+	 * The snapshots are stored inline, so an array of histories is a single contiguous allocation that can be reused for the lifetime of a server.
+	 * Acknowledging a sequence number updates the newest acknowledged snapshot, which can then be used as the baseline for delta serialization in constant time
+	 * @tparam T The type of the snapshots
+	 * @tparam N The number of snapshots to keep. Must be a power of 2, and no more than 32768
+	*/
+	template<typename T, size_t N>
+	class snapshot_history
+	{
+	public:
+		static_assert(N > 0U && (N & (N - 1U)) == 0U, "The number of snapshots must be a power of 2");
+		static_assert(N <= 0x8000U, "The number of snapshots must fit in half of the sequence number range");
+
+		snapshot_history() noexcept
+		{
+			reset();
+		}
+
+		/**
+		 * @brief Returns the slot for the snapshot with the given @p sequence, replacing the oldest snapshot in the ring.
+		 * The previous contents of the slot are not cleared, so snapshots which own memory can reuse it
+		 * @param sequence The sequence number of the snapshot that is being sent
+		 * @return The snapshot to write the state into
+		*/
+		T& insert(uint16_t sequence) noexcept
+		{
+			size_t index = sequence & mask;
+
+			m_Sequences[index] = sequence;
+			m_Acked[index] = false;
+
+			return m_Snapshots[index];
+		}
+
+		/**
+		 * @brief Marks the snapshot with the given @p sequence as received by the client.
+		 * Acknowledgements for snapshots which are no longer in the ring, or older than the current baseline, are ignored
+		 * @param sequence The sequence number that was acknowledged
+		 * @return Whether the snapshot was still in the ring
+		*/
+		bool acknowledge(uint16_t sequence) noexcept
+		{
+			size_t index = sequence & mask;
+
+			if (m_Sequences[index] != sequence)
+				return false;
+
+			m_Acked[index] = true;
+
+			if (!has_baseline() || sequence_greater_than(sequence, static_cast<uint16_t>(m_BaselineSequence)))
+				m_BaselineSequence = sequence;
+
+			return true;
+		}
+
+		/**
+		 * @brief Marks the snapshot with the given @p sequence, as well as the 32 snapshots before it, as received by the client
+		 * @param sequence The newest sequence number that was acknowledged
+		 * @param ack_bits A mask where bit i is set if the snapshot with sequence number @p sequence - 1 - i was also acknowledged
+		*/
+		void acknowledge(uint16_t sequence, uint32_t ack_bits) noexcept
+		{
+			for (; ack_bits != 0U; ack_bits &= ack_bits - 1U)
+			{
+				uint32_t offset = count_trailing_zeros64(ack_bits) + 1U;
+
+				acknowledge(static_cast<uint16_t>(sequence - offset));
+			}
+
+			acknowledge(sequence);
+		}
+
+		/**
+		 * @brief Returns whether a snapshot has been acknowledged, and is still in the ring
+		*/
+		bool has_baseline() const noexcept
+		{
+			return m_BaselineSequence != invalid_sequence && m_Sequences[m_BaselineSequence & mask] == m_BaselineSequence;
+		}
+
+		/**
+		 * @brief Returns the newest acknowledged snapshot
+		 * @return The baseline, or nullptr if no snapshot in the ring has been acknowledged
+		*/
+		const T* get_baseline() const noexcept
+		{
+			if (!has_baseline())
+				return nullptr;
+
+			return &m_Snapshots[m_BaselineSequence & mask];
+		}
+
+		/**
+		 * @brief Returns the sequence number of the newest acknowledged snapshot. Only valid if has_baseline() returns true
+		*/
+		uint16_t get_baseline_sequence() const noexcept { return static_cast<uint16_t>(m_BaselineSequence); }
+
+		/**
+		 * @brief Returns the snapshot with the given @p sequence, like the baseline chosen by the writer when reading
+		 * @param sequence The sequence number of the snapshot
+		 * @return The snapshot, or nullptr if it is no longer in the ring
+		*/
+		const T* find(uint16_t sequence) const noexcept
+		{
+			size_t index = sequence & mask;
+
+			if (m_Sequences[index] != sequence)
+				return nullptr;
+
+			return &m_Snapshots[index];
+		}
+
+		/**
+		 * @brief Returns whether the snapshot with the given @p sequence is in the ring and has been acknowledged
+		 * @param sequence The sequence number of the snapshot
+		*/
+		bool is_acked(uint16_t sequence) const noexcept
+		{
+			size_t index = sequence & mask;
+
+			return m_Sequences[index] == sequence && m_Acked[index];
+		}
+
+		/**
+		 * @brief Forgets all snapshots, like when a client reconnects. The snapshots themselves are kept, so their memory can be reused
+		*/
+		void reset() noexcept
+		{
+			for (size_t i = 0U; i < N; i++)
+			{
+				m_Sequences[i] = invalid_sequence;
+				m_Acked[i] = false;
+			}
+
+			m_BaselineSequence = invalid_sequence;
+		}
+
+	private:
+		static constexpr size_t mask = N - 1U;
+		static constexpr uint32_t invalid_sequence = ~0U;
+
+	private:
+		T m_Snapshots[N]{};
+		uint32_t m_Sequences[N];
+		bool m_Acked[N];
+		uint32_t m_BaselineSequence;
+	};
+}
\ No newline at end of file
@@ -39,6 +39,17 @@ newoption {
     }
 }
 
+newoption {
+    trigger = "simd",
+    value = "SIMD",
+    description = "The instruction set extensions to compile with",
+    default = "default",
+    allowed = {
+        { "default", "Whatever the toolset enables by default" },
+        { "avx2", "AVX2, FMA and F16C, to cover the wider SIMD paths" }
+    }
+}
+
 require "scripts/build"
 require "scripts/test"
 
@@ -139,6 +150,13 @@ project "Test"
     filter "platforms:x64"
         architecture "x86_64"
     
+    -- SIMD
+    filter "options:simd=avx2"
+        vectorextensions "AVX2"
+    
+    filter { "options:simd=avx2", "toolset:not msc" }
+        buildoptions { "-mfma", "-mf16c" }
+    
     -- Config
     filter "configurations:debug"
         defines { "BS_DEBUG_BREAK" }
@@ -23,6 +23,18 @@ namespace bitstream::test
 		}
 	};
 
+    struct vector3
+    {
+        float values[3];
+
+        float operator[](size_t index) const
+        {
+            BS_TEST_ASSERT(index < 3);
+
+            return values[index];
+        }
+    };
+
     struct custom_type
     {
         bool enabled = true;
@@ -0,0 +1,225 @@
+#include "../shared/assert.h"
+#include "../shared/test.h"
+
+#include <bitstream/stream/bit_reader.h>
+#include <bitstream/stream/bit_writer.h>
+#include <bitstream/stream/buffer_pool.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bitstream::test::pool
+{
+	BS_ADD_TEST(test_buffer_pool_serialize)
+	{
+		buffer_pool<64> pool(4);
+
+		auto buffer = pool.acquire();
+		BS_TEST_ASSERT(buffer);
+		BS_TEST_ASSERT_OPERATION(reinterpret_cast<uintptr_t>(buffer->Bytes) % 64U, == , 0U);
+
+		// Use the buffer with a fixed_policy
+		uint32_t value_in = 1337U;
+
+		fixed_bit_writer writer(*buffer);
+
+		BS_TEST_ASSERT(writer.serialize_bits(value_in, 32U));
+		uint32_t num_bits = writer.flush();
+
+
+		uint32_t value_out;
+		fixed_bit_reader reader(*buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize_bits(value_out, 32U));
+
+		BS_TEST_ASSERT_OPERATION(value_out, == , value_in);
+	}
+
+	BS_ADD_TEST(test_buffer_pool_exhausted)
+	{
+		using pool_type = buffer_pool<32, 64, 2>;
+
+		pool_type pool(24);
+
+		// Acquire every buffer, which should all be different
+		pool_type::handle buffers[24];
+		for (auto& buffer : buffers)
+		{
+			buffer = pool.acquire();
+			BS_TEST_ASSERT(buffer);
+		}
+
+		for (uint32_t i = 0; i < 24; i++)
+		{
+			for (uint32_t j = i + 1U; j < 24; j++)
+				BS_TEST_ASSERT(buffers[i].get() != buffers[j].get());
+		}
+
+		BS_TEST_ASSERT(!pool.acquire());
+
+		// Releasing more buffers than the thread cache holds should put the rest back in the freelist
+		for (auto& buffer : buffers)
+			buffer.reset();
+
+		for (auto& buffer : buffers)
+		{
+			buffer = pool.acquire();
+			BS_TEST_ASSERT(buffer);
+		}
+
+		BS_TEST_ASSERT(!pool.acquire());
+	}
+
+	BS_ADD_TEST(test_buffer_pool_handle)
+	{
+		buffer_pool<32> pool(1);
+
+		// Moving a handle should transfer ownership of the buffer
+		auto buffer = pool.acquire();
+		byte_buffer<32>* pointer = buffer.get();
+
+		auto moved = std::move(buffer);
+		BS_TEST_ASSERT(!buffer);
+		BS_TEST_ASSERT(moved.get() == pointer);
+		BS_TEST_ASSERT(!pool.acquire());
+
+		// Destroying the handle should return the buffer, which is reused from the freelist since the pool is too small to cache
+		{
+			auto destroyed = std::move(moved);
+		}
+
+		auto reused = pool.acquire();
+		BS_TEST_ASSERT(reused.get() == pointer);
+	}
+
+	BS_ADD_TEST(test_buffer_pool_multiple)
+	{
+		buffer_pool<32> pool1(8);
+		buffer_pool<32> pool2(8);
+
+		// The thread cache is used by pool1, so buffers from pool2 should go back to its freelist
+		auto buffer1 = pool1.acquire();
+		auto buffer2 = pool2.acquire();
+		byte_buffer<32>* pointer1 = buffer1.get();
+		byte_buffer<32>* pointer2 = buffer2.get();
+
+		buffer1.reset();
+		buffer2.reset();
+
+		auto reused2 = pool2.acquire();
+		BS_TEST_ASSERT(reused2.get() == pointer2);
+
+		auto reused1 = pool1.acquire();
+		BS_TEST_ASSERT(reused1.get() == pointer1);
+		reused1.reset();
+
+		// Flushing the cache should make the buffer available to other threads
+		pool1.flush_thread_cache();
+
+		uint32_t num_acquired = 0U;
+		std::thread thread([&]
+		{
+			std::vector<buffer_pool<32>::handle> buffers;
+			while (auto buffer = pool1.acquire())
+				buffers.push_back(std::move(buffer));
+
+			num_acquired = static_cast<uint32_t>(buffers.size());
+		});
+
+		thread.join();
+
+		BS_TEST_ASSERT_OPERATION(num_acquired, == , 8U);
+	}
+
+	BS_ADD_TEST(test_buffer_pool_cross_thread)
+	{
+		buffer_pool<256> pool(8);
+
+		std::vector<buffer_pool<256>::handle> buffers;
+		while (auto buffer = pool.acquire())
+			buffers.push_back(std::move(buffer));
+
+		BS_TEST_ASSERT_OPERATION(buffers.size(), == , 8U);
+
+		// Buffers released by another thread should be available to this one again
+		std::thread consumer([&] { buffers.clear(); });
+		consumer.join();
+
+		while (auto buffer = pool.acquire())
+			buffers.push_back(std::move(buffer));
+
+		BS_TEST_ASSERT_OPERATION(buffers.size(), == , 8U);
+		buffers.clear();
+
+		// Buffers cached by a thread should be returned when it exits
+		std::thread producer([&]
+		{
+			for (uint32_t i = 0; i < 8; i++)
+				pool.acquire().reset();
+		});
+		producer.join();
+
+		while (auto buffer = pool.acquire())
+			buffers.push_back(std::move(buffer));
+
+		BS_TEST_ASSERT_OPERATION(buffers.size(), == , 8U);
+	}
+
+	BS_ADD_TEST(test_buffer_pool_stress)
+	{
+		using pool_type = buffer_pool<64, 64, 8>;
+
+		pool_type pool(64);
+
+		std::atomic<uint32_t> num_corrupted{ 0U };
+
+		// Every thread fills its buffers with its own value, and keeps some of them around for a while
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < 4; t++)
+		{
+			threads.emplace_back([&pool, &num_corrupted, t]
+			{
+				uint8_t value = static_cast<uint8_t>(t + 1U);
+
+				std::vector<pool_type::handle> held;
+				for (uint32_t i = 0; i < 20000; i++)
+				{
+					auto buffer = pool.acquire();
+					if (buffer)
+					{
+						std::memset(buffer->Bytes, value, 64U);
+						std::this_thread::yield();
+
+						for (uint32_t j = 0; j < 64; j++)
+						{
+							if (buffer->Bytes[j] != value)
+								num_corrupted.fetch_add(1U, std::memory_order_relaxed);
+						}
+
+						if (i % 3U == 0U)
+							held.push_back(std::move(buffer));
+					}
+
+					if (held.size() > 4U)
+						held.clear();
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		BS_TEST_ASSERT_OPERATION(num_corrupted.load(), == , 0U);
+
+		// Every buffer should be available once the threads have exited
+		std::vector<pool_type::handle> buffers;
+		while (auto buffer = pool.acquire())
+			buffers.push_back(std::move(buffer));
+
+		BS_TEST_ASSERT_OPERATION(buffers.size(), == , 64U);
+	}
+}
\ No newline at end of file
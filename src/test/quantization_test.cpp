@@ -3,11 +3,14 @@
 #include "../shared/test_types.h"
 
 #include <bitstream/quantization/bounded_range.h>
+#include <bitstream/quantization/bounded_range_d.h>
 #include <bitstream/quantization/half_precision.h>
+#include <bitstream/quantization/octahedral_normal.h>
 #include <bitstream/quantization/smallest_three.h>
 
 #include <cmath>
 #include <cstddef>
+#include <limits>
 
 namespace bitstream::test::quantization
 {
@@ -24,6 +27,33 @@ namespace bitstream::test::quantization
 		BS_TEST_ASSERT_OPERATION(std::abs(value_in - value_out), <=, epsilon);
 	}
 
+	BS_ADD_TEST(test_half_precision_batch)
+	{
+		// Test a batch which isn't a multiple of the SIMD width, including subnormals, overflow and infinity
+		float values_in[21];
+		for (size_t i = 0; i < 18; i++)
+			values_in[i] = std::ldexp(i % 2 == 0 ? 1.3f : -0.7f, static_cast<int>(i) * 3 - 27);
+
+		values_in[18] = 0.0f;
+		values_in[19] = -70000.0f;
+		values_in[20] = std::numeric_limits<float>::infinity();
+
+		uint16_t quantized_values[21];
+		half_precision::quantize(values_in, quantized_values, 21);
+
+		float values_out[21];
+		half_precision::dequantize(quantized_values, values_out, 21);
+
+		for (size_t i = 0; i < 21; i++)
+		{
+			BS_TEST_ASSERT_OPERATION(quantized_values[i], ==, half_precision::quantize(values_in[i]));
+			BS_TEST_ASSERT_OPERATION(values_out[i], ==, half_precision::dequantize(quantized_values[i]));
+		}
+
+		BS_TEST_ASSERT_OPERATION(values_out[19], ==, -std::numeric_limits<float>::infinity());
+		BS_TEST_ASSERT_OPERATION(values_out[20], ==, std::numeric_limits<float>::infinity());
+	}
+
 	BS_ADD_TEST(test_bounded_range)
 	{
 		float value_in = 3.141592f;
@@ -38,6 +68,61 @@ namespace bitstream::test::quantization
 		BS_TEST_ASSERT_OPERATION(range.get_bits_required(), <, 32);
 	}
 
+	BS_ADD_TEST(test_bounded_range_d)
+	{
+		double value_in = 123456.789012;
+
+		constexpr bounded_range_d range(-1000000.0, 1000000.0, 0.000001);
+
+		uint64_t quantized_value = range.quantize(value_in);
+
+		double value_out = range.dequantize(quantized_value);
+
+		BS_TEST_ASSERT_OPERATION(std::abs(value_in - value_out), <=, range.get_precision());
+		BS_TEST_ASSERT_OPERATION(range.get_bits_required(), ==, 41);
+
+		// Ranges may need all 64 bits
+		constexpr bounded_range_d full_range(0.0, 18446744073709549568.0, 1.0);
+
+		BS_TEST_ASSERT_OPERATION(full_range.get_bits_required(), ==, 64);
+		BS_TEST_ASSERT_OPERATION(full_range.quantize(18446744073709549568.0), ==, 18446744073709549568ULL);
+
+		// Ranges with 2^64 steps or more should be clamped to the largest 64-bit value
+		constexpr uint64_t max_steps = (std::numeric_limits<uint64_t>::max)();
+		constexpr bounded_range_d limit_range(0.0, 18446744073709551616.0, 1.0);
+
+		BS_TEST_ASSERT_OPERATION(limit_range.get_bits_required(), ==, 64);
+		BS_TEST_ASSERT_OPERATION(limit_range.quantize(0.0), ==, 0U);
+		BS_TEST_ASSERT_OPERATION(limit_range.quantize(18446744073709551616.0), ==, max_steps);
+
+		constexpr bounded_range_d huge_range(-1e300, 1e300, 1.0);
+
+		BS_TEST_ASSERT_OPERATION(huge_range.get_bits_required(), ==, 64);
+		BS_TEST_ASSERT_OPERATION(huge_range.quantize(1e300), ==, max_steps);
+	}
+
+	BS_ADD_TEST(test_bounded_range_batch)
+	{
+		// Test a batch which isn't a multiple of the SIMD width, with some values outside the range
+		float values_in[37];
+		for (size_t i = 0; i < 37; i++)
+			values_in[i] = -1.0f + static_cast<float>(i) * 0.19f;
+
+		constexpr bounded_range range(0.0f, 5.0f, 0.0001f);
+
+		uint32_t quantized_values[37];
+		range.quantize(values_in, quantized_values, 37);
+
+		float values_out[37];
+		range.dequantize(quantized_values, values_out, 37);
+
+		for (size_t i = 0; i < 37; i++)
+		{
+			BS_TEST_ASSERT_OPERATION(quantized_values[i], ==, range.quantize(values_in[i]));
+			BS_TEST_ASSERT_OPERATION(values_out[i], ==, range.dequantize(quantized_values[i]));
+		}
+	}
+
 	BS_ADD_TEST(test_smallest_three)
 	{
 		quaternion quat_in{ 0.0f, std::sin(2.0f), std::cos(2.0f), 0.0f };
@@ -54,4 +139,101 @@ namespace bitstream::test::quantization
 
 		BS_TEST_ASSERT_OPERATION(dot, >=, (1.0f - epsilon));
 	}
-}
\ No newline at end of file
+
+	BS_ADD_TEST(test_smallest_three_batch)
+	{
+		// Test a batch which isn't a multiple of the SIMD width, with the largest component in every position and sign
+		float components[4][23];
+		for (size_t i = 0; i < 23; i++)
+		{
+			float angle = static_cast<float>(i) * 0.7f;
+			float x = std::sin(angle) * 0.5f;
+			float y = std::cos(angle * 1.3f) * 0.5f;
+			float z = std::sin(angle * 2.1f) * 0.5f;
+			float w = std::sqrt(std::abs(1.0f - (x * x + y * y + z * z)));
+
+			components[i % 4][i] = i % 8 < 4 ? w : -w;
+			components[(i + 1) % 4][i] = x;
+			components[(i + 2) % 4][i] = y;
+			components[(i + 3) % 4][i] = z;
+		}
+
+		using trait = smallest_three<quaternion, 11>;
+
+		uint32_t quantized[4][23];
+		trait::quantize({ components[0], components[1], components[2], components[3] }, { quantized[0], quantized[1], quantized[2], quantized[3] }, 23);
+
+		float components_out[4][23];
+		trait::dequantize({ quantized[0], quantized[1], quantized[2], quantized[3] }, { components_out[0], components_out[1], components_out[2], components_out[3] }, 23);
+
+		for (size_t i = 0; i < 23; i++)
+		{
+			quaternion quat_in{ components[0][i], components[1][i], components[2][i], components[3][i] };
+			quantized_quaternion quantized_quat = trait::quantize(quat_in);
+
+			BS_TEST_ASSERT_OPERATION(quantized[0][i], ==, quantized_quat.m);
+			BS_TEST_ASSERT_OPERATION(quantized[1][i], ==, quantized_quat.a);
+			BS_TEST_ASSERT_OPERATION(quantized[2][i], ==, quantized_quat.b);
+			BS_TEST_ASSERT_OPERATION(quantized[3][i], ==, quantized_quat.c);
+
+			quaternion quat_out = trait::dequantize(quantized_quat);
+			for (size_t k = 0; k < 4; k++)
+				BS_TEST_ASSERT_OPERATION(components_out[k][i], ==, quat_out[k]);
+		}
+	}
+
+	BS_ADD_TEST(test_octahedral_normal)
+	{
+		vector3 vector_in{ 0.48f, -0.6f, -0.64f };
+
+		auto quantized_vector = octahedral_normal<vector3, 11>::quantize(vector_in);
+		vector3 vector_out = octahedral_normal<vector3, 11>::dequantize(quantized_vector);
+
+		constexpr float epsilon = 2e-3f;
+
+		for (size_t i = 0; i < 3; i++)
+			BS_TEST_ASSERT_OPERATION(std::abs(vector_in[i] - vector_out[i]), <=, epsilon);
+	}
+
+	BS_ADD_TEST(test_octahedral_normal_batch)
+	{
+		// Test a batch which isn't a multiple of the SIMD width, covering every octant and the zero vector
+		float components[3][27];
+		for (size_t i = 0; i < 26; i++)
+		{
+			float x = (i & 1 ? -1.0f : 1.0f) * (0.1f + static_cast<float>(i) * 0.03f);
+			float y = (i & 2 ? -1.0f : 1.0f) * 0.5f;
+			float z = (i & 4 ? -1.0f : 1.0f) * (0.9f - static_cast<float>(i) * 0.03f);
+			float length = std::sqrt(x * x + y * y + z * z);
+
+			components[0][i] = x / length;
+			components[1][i] = y / length;
+			components[2][i] = z / length;
+		}
+
+		components[0][26] = 0.0f;
+		components[1][26] = 0.0f;
+		components[2][26] = 0.0f;
+
+		using trait = octahedral_normal<vector3, 10>;
+
+		uint32_t quantized[2][27];
+		trait::quantize({ components[0], components[1], components[2] }, { quantized[0], quantized[1] }, 27);
+
+		float components_out[3][27];
+		trait::dequantize({ quantized[0], quantized[1] }, { components_out[0], components_out[1], components_out[2] }, 27);
+
+		for (size_t i = 0; i < 27; i++)
+		{
+			vector3 vector_in{ components[0][i], components[1][i], components[2][i] };
+			quantized_normal quantized_vector = trait::quantize(vector_in);
+
+			BS_TEST_ASSERT_OPERATION(quantized[0][i], ==, quantized_vector.u);
+			BS_TEST_ASSERT_OPERATION(quantized[1][i], ==, quantized_vector.v);
+
+			vector3 vector_out = trait::dequantize(quantized_vector);
+			for (size_t k = 0; k < 3; k++)
+				BS_TEST_ASSERT_OPERATION(components_out[k][i], ==, vector_out[k]);
+		}
+	}
+}
@@ -0,0 +1,240 @@
+#include "../shared/assert.h"
+#include "../shared/test.h"
+
+#include <bitstream/stream/bit_reader.h>
+#include <bitstream/stream/bit_writer.h>
+#include <bitstream/stream/segmented_buffer.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace bitstream::test::segmented
+{
+	// Small chunks, so that most writes cross a chunk boundary
+	using buffer_type = segmented_buffer<16>;
+	using writer_type = segmented_bit_writer<16>;
+	using reader_type = segmented_bit_reader<16>;
+
+	template<typename Stream>
+	bool serialize_values(Stream& stream, uint8_t* bytes)
+	{
+		for (uint32_t i = 0; i < 20; i++)
+		{
+			uint32_t value = i * 37U;
+			BS_ASSERT(stream.serialize_bits(value, 13));
+		}
+
+		// Bytes which are not word-aligned
+		BS_ASSERT(stream.serialize_bytes(bytes, 40U * 8U));
+
+		// Bytes which are word-aligned
+		BS_ASSERT(stream.pad(4U - stream.get_num_bytes_serialized() % 4U));
+		BS_ASSERT(stream.serialize_bytes(bytes, 40U * 8U));
+
+		return true;
+	}
+
+	BS_ADD_TEST(test_segmented_buffer_serialize)
+	{
+		uint8_t bytes_in[40];
+		for (uint32_t i = 0; i < 40; i++)
+			bytes_in[i] = static_cast<uint8_t>(i * 7U + 1U);
+
+		// Write the same values into a contiguous buffer and a segmented one
+		byte_buffer<256> compare_buffer;
+		fixed_bit_writer compare_writer(compare_buffer);
+
+		BS_TEST_ASSERT(serialize_values(compare_writer, bytes_in));
+		uint32_t num_bits = compare_writer.flush();
+
+		buffer_type buffer;
+		writer_type writer(buffer);
+
+		BS_TEST_ASSERT(serialize_values(writer, bytes_in));
+		BS_TEST_ASSERT_OPERATION(writer.flush(), == , num_bits);
+
+		// The chunks should contain the same bytes
+		uint32_t num_bytes = (num_bits + 7U) / 8U;
+		BS_TEST_ASSERT_OPERATION(buffer.get_capacity(), >= , num_bytes);
+
+		for (uint32_t i = 0; i < num_bytes; i++)
+			BS_TEST_ASSERT_OPERATION(buffer.get_chunk(i / 16U)[i % 16U], == , compare_buffer.Bytes[i]);
+
+
+		// Read the values back
+		uint8_t bytes_out[40];
+		reader_type reader(buffer, num_bits);
+
+		for (uint32_t i = 0; i < 20; i++)
+		{
+			uint32_t value;
+			BS_TEST_ASSERT(reader.serialize_bits(value, 13));
+			BS_TEST_ASSERT_OPERATION(value, == , i * 37U);
+		}
+
+		BS_TEST_ASSERT(reader.serialize_bytes(bytes_out, 40U * 8U));
+		BS_TEST_ASSERT(std::memcmp(bytes_in, bytes_out, 40U) == 0);
+
+		BS_TEST_ASSERT(reader.pad(4U - reader.get_num_bytes_serialized() % 4U));
+		BS_TEST_ASSERT(reader.serialize_bytes(bytes_out, 40U * 8U));
+		BS_TEST_ASSERT(std::memcmp(bytes_in, bytes_out, 40U) == 0);
+
+		BS_TEST_ASSERT_OPERATION(reader.get_remaining_bits(), == , 0U);
+	}
+
+	BS_ADD_TEST(test_segmented_buffer_serialize_into)
+	{
+		// Copy a segmented buffer into a contiguous one, at an offset
+		buffer_type buffer;
+		writer_type writer(buffer);
+
+		for (uint32_t i = 0; i < 30; i++)
+			BS_TEST_ASSERT(writer.serialize_bits(i, 11));
+
+		byte_buffer<64> fixed_buffer;
+		fixed_bit_writer fixed_writer(fixed_buffer);
+
+		BS_TEST_ASSERT(fixed_writer.serialize_bits(5U, 3));
+		BS_TEST_ASSERT(writer.serialize_into(fixed_writer));
+
+		// And back into another segmented buffer, which is also at an offset
+		buffer_type copy_buffer;
+		writer_type copy_writer(copy_buffer);
+
+		BS_TEST_ASSERT(copy_writer.serialize_bits(1U, 1));
+		BS_TEST_ASSERT(fixed_writer.serialize_into(copy_writer));
+		uint32_t num_bits = copy_writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 1U + 3U + 30U * 11U);
+
+
+		reader_type reader(copy_buffer, num_bits);
+
+		uint32_t first;
+		uint32_t second;
+		BS_TEST_ASSERT(reader.serialize_bits(first, 1));
+		BS_TEST_ASSERT(reader.serialize_bits(second, 3));
+
+		BS_TEST_ASSERT_OPERATION(first, == , 1U);
+		BS_TEST_ASSERT_OPERATION(second, == , 5U);
+
+		for (uint32_t i = 0; i < 30; i++)
+		{
+			uint32_t value;
+			BS_TEST_ASSERT(reader.serialize_bits(value, 11));
+			BS_TEST_ASSERT_OPERATION(value, == , i);
+		}
+	}
+
+	BS_ADD_TEST(test_segmented_buffer_pad)
+	{
+		// Padding an empty buffer should zero every chunk it covers
+		buffer_type buffer;
+		buffer.copy_from("This will be overwritten with zeros", 36U);
+
+		writer_type writer(buffer);
+
+		BS_TEST_ASSERT(writer.pad_to_size(36U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 36U * 8U);
+
+		for (uint32_t i = 0; i < 36; i++)
+			BS_TEST_ASSERT_OPERATION(buffer.get_chunk(i / 16U)[i % 16U], == , 0U);
+	}
+
+	BS_ADD_TEST(test_segmented_buffer_read_bounds)
+	{
+		// A reader should be bounded by the chunks in the buffer, even if asked for more
+		buffer_type buffer;
+		buffer.copy_from("0123456789ABCDEF", 16U);
+
+		reader_type reader(buffer, 1000U * 32U);
+
+		BS_TEST_ASSERT_OPERATION(reader.get_total_bits(), == , 16U * 8U);
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			uint32_t value;
+			BS_TEST_ASSERT(reader.serialize_bits(value, 32));
+		}
+
+		BS_TEST_ASSERT(!reader.can_serialize_bits(1U));
+
+		// Without a bit count, the reader should cover the whole buffer
+		reader_type unbounded_reader(buffer);
+
+		BS_TEST_ASSERT_OPERATION(unbounded_reader.get_total_bits(), == , 16U * 8U);
+
+#ifndef BS_DEBUG_BREAK // Failing to read would break into the debugger
+		uint32_t value;
+		BS_TEST_ASSERT(unbounded_reader.serialize_bits(value, 32));
+		BS_TEST_ASSERT(unbounded_reader.serialize_bytes(reinterpret_cast<uint8_t*>(&value), 32U));
+		BS_TEST_ASSERT(!unbounded_reader.serialize_bytes(reinterpret_cast<uint8_t*>(&value), 32U * 3U));
+#endif // BS_DEBUG_BREAK
+
+		// Reading should never allocate more chunks
+		BS_TEST_ASSERT_OPERATION(buffer.get_num_chunks(), == , 1U);
+	}
+
+#ifdef BS_HAS_IOVEC
+	BS_ADD_TEST(test_segmented_buffer_iovec)
+	{
+		buffer_type buffer;
+		writer_type writer(buffer);
+
+		for (uint32_t i = 0; i < 10; i++)
+			BS_TEST_ASSERT(writer.serialize_bits(0xABCD0000U | i, 32));
+		BS_TEST_ASSERT(writer.serialize_bits(3U, 2));
+		uint32_t num_bits = writer.flush();
+
+		// The output should be one iovec per chunk, with the last one cut short
+		iovec vecs[4];
+		size_t num_vecs = buffer.get_iovecs(vecs, 4, writer.get_num_bytes_serialized());
+
+		BS_TEST_ASSERT_OPERATION(num_vecs, == , 3U);
+		BS_TEST_ASSERT_OPERATION(vecs[0].iov_len, == , 16U);
+		BS_TEST_ASSERT_OPERATION(vecs[1].iov_len, == , 16U);
+		BS_TEST_ASSERT_OPERATION(vecs[2].iov_len, == , 9U);
+		BS_TEST_ASSERT(vecs[1].iov_base == buffer.get_chunk(1));
+
+		// Too few iovecs should fail
+		BS_TEST_ASSERT_OPERATION(buffer.get_iovecs(vecs, 2, writer.get_num_bytes_serialized()), == , 0U);
+
+		// Gather the output into a contiguous buffer
+		byte_buffer<64> gathered;
+		size_t offset = 0U;
+		for (size_t i = 0U; i < num_vecs; i++)
+		{
+			std::memcpy(gathered.Bytes + offset, vecs[i].iov_base, vecs[i].iov_len);
+			offset += vecs[i].iov_len;
+		}
+
+		// Scatter it into uneven pieces, and read them back through another buffer
+		iovec pieces[3]
+		{
+			{ gathered.Bytes, 5U },
+			{ gathered.Bytes + 5U, 30U },
+			{ gathered.Bytes + 35U, offset - 35U }
+		};
+
+		buffer_type read_buffer;
+		BS_TEST_ASSERT_OPERATION(read_buffer.copy_from(pieces, 3U), == , offset);
+
+		reader_type reader(read_buffer, num_bits);
+
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			uint32_t expected = 0xABCD0000U | i;
+
+			uint32_t value;
+			BS_TEST_ASSERT(reader.serialize_bits(value, 32));
+			BS_TEST_ASSERT_OPERATION(value, == , expected);
+		}
+
+		uint32_t last_value;
+		BS_TEST_ASSERT(reader.serialize_bits(last_value, 2));
+		BS_TEST_ASSERT_OPERATION(last_value, == , 3U);
+	}
+#endif // BS_HAS_IOVEC
+}
\ No newline at end of file
@@ -49,4 +49,241 @@ namespace bitstream::test::traits
 			BS_TEST_ASSERT(values_out[i] == values_in[i]);
 		}
 	}
+
+	BS_ADD_TEST(test_serialize_array_subset_dense)
+	{
+		using trait = array_subset<uint32_t, bounded_int<uint32_t, 0U, 255U>>;
+
+		// Test a dense subset, which is cheaper to write as a bit mask
+		uint32_t values_in[40];
+		for (uint32_t i = 0; i < 40; i++)
+			values_in[i] = (i % 3 == 0) ? 0 : i;
+
+		auto compare = [](uint32_t value) { return value != 0; };
+
+		byte_buffer<64> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 40, compare));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 1 + 40 + 26 * 8);
+
+
+		uint32_t values_out[40]{};
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 40));
+
+		for (int i = 0; i < 40; i++)
+			BS_TEST_ASSERT_OPERATION(values_out[i], == , values_in[i]);
+	}
+
+	BS_ADD_TEST(test_serialize_array_subset_sparse)
+	{
+		using trait = array_subset<uint32_t, bounded_int<uint32_t, 0U, 255U>>;
+
+		// Test a sparse subset, with gaps of every size
+		uint32_t values_in[1000]{};
+		values_in[0] = 1;
+		values_in[3] = 2;
+		values_in[40] = 3;
+		values_in[170] = 4;
+		values_in[998] = 5;
+
+		auto compare = [](uint32_t value) { return value != 0; };
+
+		byte_buffer<64> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 1000, compare));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 1 + (1 + 4 + 10 + 16 + 16 + 4) + 5 * 8);
+
+
+		uint32_t values_out[1000]{};
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 1000));
+
+		for (int i = 0; i < 1000; i++)
+			BS_TEST_ASSERT_OPERATION(values_out[i], == , values_in[i]);
+
+		// An empty subset only writes the final difference
+		writer = fixed_bit_writer(buffer);
+
+		uint32_t empty_values[1000]{};
+		BS_TEST_ASSERT(writer.serialize<trait>(empty_values, 1000, compare));
+		num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 1 + 6 + 10);
+
+		reader = fixed_bit_reader(buffer, num_bits);
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 1000));
+	}
+
+	BS_ADD_TEST(test_serialize_array_subset_mask)
+	{
+		using trait = array_subset<uint32_t, bounded_int<uint32_t, 0U, 255U>>;
+
+		// Test building a mask from flags, which should give the same result as a compare function
+		uint32_t values_in[200]{};
+		bool dirty[200]{};
+		for (uint32_t i = 0; i < 200; i += 37)
+		{
+			values_in[i] = i + 1;
+			dirty[i] = true;
+		}
+
+		uint64_t mask[4];
+		utility::pack_flags(dirty, 200, mask);
+
+		byte_buffer<512> compare_buffer;
+		fixed_bit_writer compare_writer(compare_buffer);
+
+		BS_TEST_ASSERT(compare_writer.serialize<trait>(values_in, 200, [](uint32_t value) { return value != 0; }));
+		BS_TEST_ASSERT(compare_writer.serialize<trait>(values_in, 200, [](uint32_t value) { return value == 0; }));
+		uint32_t compare_bits = compare_writer.flush();
+
+		byte_buffer<512> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 200, mask));
+
+		// The inverse is cheaper to write as a bit mask
+		for (uint64_t& word : mask)
+			word = ~word;
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 200, mask));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , compare_bits);
+
+		for (uint32_t i = 0; i < num_bits / 32; i++)
+			BS_TEST_ASSERT_OPERATION(reinterpret_cast<uint32_t*>(buffer.Bytes)[i], == , reinterpret_cast<uint32_t*>(compare_buffer.Bytes)[i]);
+
+
+		uint32_t values_out[200]{};
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 200));
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 200));
+
+		for (int i = 0; i < 200; i++)
+			BS_TEST_ASSERT_OPERATION(values_out[i], == , values_in[i]);
+	}
+
+	BS_ADD_TEST(test_serialize_array_subset_compare_once)
+	{
+		using trait = array_subset<uint32_t, bounded_int<uint32_t, 0U, 255U>>;
+
+		// Test that the compare function is only called once per object, with an array too big for the stack mask
+		static uint32_t values_in[5000]{};
+		for (uint32_t i = 0; i < 5000; i += 97)
+			values_in[i] = i % 255 + 1;
+
+		uint32_t num_calls = 0;
+		auto compare = [&num_calls](uint32_t value) { num_calls++; return value != 0; };
+
+		byte_buffer<1024> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 5000, compare));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_calls, == , 5000U);
+
+
+		static uint32_t values_out[5000]{};
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 5000));
+
+		for (int i = 0; i < 5000; i++)
+			BS_TEST_ASSERT_OPERATION(values_out[i], == , values_in[i]);
+	}
+
+	BS_ADD_TEST(test_pack_not_equal)
+	{
+		// Test comparing version counters, with a length that isn't a multiple of the SIMD width
+		uint32_t current[71];
+		uint32_t previous[71];
+		for (uint32_t i = 0; i < 71; i++)
+		{
+			current[i] = i * 3;
+			previous[i] = i % 5 == 0 ? i : i * 3;
+		}
+
+		uint64_t mask[2];
+		utility::pack_not_equal(current, previous, 71, mask);
+
+		for (uint32_t i = 0; i < 71; i++)
+		{
+			bool changed = (mask[i / 64] >> (i % 64)) & 1U;
+			BS_TEST_ASSERT(changed == (i % 5 == 0 && i != 0));
+		}
+
+		BS_TEST_ASSERT_OPERATION(mask[1] >> 7, == , 0U);
+	}
+
+	BS_ADD_TEST(test_serialize_for_packed)
+	{
+		using trait = for_packed<int32_t, 16U>;
+
+		// Test a narrow range of values with a few outliers
+		int32_t values_in[40];
+		for (int32_t i = 0; i < 40; i++)
+			values_in[i] = -1000 + (i * 7) % 13;
+
+		values_in[3] = 250000;
+		values_in[20] = -90000;
+		values_in[37] = 12;
+
+		byte_buffer<256> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 40U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, < , 40U * 8U * sizeof(int32_t) / 2U);
+
+
+		int32_t values_out[40];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 40U));
+
+		for (int i = 0; i < 40; i++)
+			BS_TEST_ASSERT_OPERATION(values_out[i], == , values_in[i]);
+	}
+
+	BS_ADD_TEST(test_serialize_for_packed_wide)
+	{
+		using trait = for_packed<uint64_t>;
+
+		// Test values which are far apart and use the full range of the type
+		uint64_t values_in[5]
+		{
+			0ULL,
+			(std::numeric_limits<uint64_t>::max)(),
+			0x123456789ULL,
+			0x123456789ULL,
+			42ULL
+		};
+
+		byte_buffer<64> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 5U));
+		uint32_t num_bits = writer.flush();
+
+
+		uint64_t values_out[5];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 5U));
+
+		for (int i = 0; i < 5; i++)
+			BS_TEST_ASSERT_OPERATION(values_out[i], == , values_in[i]);
+	}
 }
\ No newline at end of file
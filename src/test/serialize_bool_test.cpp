@@ -6,6 +6,9 @@
 
 #include <bitstream/traits/bool_trait.h>
 
+#include <bitset>
+#include <vector>
+
 namespace bitstream::test::traits
 {
 	BS_ADD_TEST(test_serialize_bool_aligned)
@@ -59,4 +62,93 @@ namespace bitstream::test::traits
 		BS_TEST_ASSERT_OPERATION(out_value, == , value);
 		//BS_TEST_ASSERT_OPERATION(*reinterpret_cast<uint8_t*>(&out_value), == , 1U);
 	}
-}
\ No newline at end of file
+
+	BS_ADD_TEST(test_serialize_bool_array)
+	{
+		// Test a bool array spanning more than one word, with a length that isn't a multiple of the SIMD width
+		bool values[100];
+		for (uint32_t i = 0; i < 100; i++)
+			values[i] = i % 3 == 0 || i % 7 == 0;
+
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize_bits(3U, 2U));
+		BS_TEST_ASSERT(writer.serialize<bool[100]>(values));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 102);
+
+		// The bools should be written in order
+		uint32_t first_word = utility::to_big_endian32(reinterpret_cast<uint32_t*>(buffer.Bytes)[0]);
+		BS_TEST_ASSERT_OPERATION(first_word >> 26, == , 0b111001U);
+
+		// Read the bools back and validate
+		uint32_t out_padding;
+		bool out_values[100];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize_bits(out_padding, 2U));
+		BS_TEST_ASSERT(reader.serialize<bool[100]>(out_values));
+
+		for (uint32_t i = 0; i < 100; i++)
+			BS_TEST_ASSERT_OPERATION(out_values[i], == , values[i]);
+	}
+
+	BS_ADD_TEST(test_serialize_bitset)
+	{
+		// Test a bitset, which should be written the same as a bool array
+		std::bitset<70> value;
+		bool values[70];
+		for (uint32_t i = 0; i < 70; i++)
+		{
+			value[i] = i % 5 == 1;
+			values[i] = i % 5 == 1;
+		}
+
+		byte_buffer<32> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<std::bitset<70>>(value));
+		BS_TEST_ASSERT(writer.serialize<bool[70]>(values));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 140);
+
+		// Read it back as the other type and validate
+		std::bitset<70> out_value;
+		bool out_values[70];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<bool[70]>(out_values));
+		BS_TEST_ASSERT(reader.serialize<std::bitset<70>>(out_value));
+
+		BS_TEST_ASSERT(out_value == value);
+		for (uint32_t i = 0; i < 70; i++)
+			BS_TEST_ASSERT_OPERATION(out_values[i], == , values[i]);
+	}
+
+	BS_ADD_TEST(test_serialize_bool_vector)
+	{
+		// Test a vector of bools, prefixed by its size
+		std::vector<bool> value(67);
+		for (uint32_t i = 0; i < 67; i++)
+			value[i] = i % 4 == 0;
+
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<std::vector<bool>>(value, 100U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 7 + 67);
+
+		// Read it back into a vector of a different size
+		std::vector<bool> out_value(3, true);
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<std::vector<bool>>(out_value, 100U));
+
+		BS_TEST_ASSERT(out_value == value);
+	}
+}
@@ -0,0 +1,122 @@
+#include "../shared/assert.h"
+#include "../shared/test.h"
+#include "../shared/test_types.h"
+
+#include <bitstream/stream/bit_measure.h>
+#include <bitstream/stream/bit_reader.h>
+#include <bitstream/stream/bit_writer.h>
+
+#include <bitstream/traits/cached_trait.h>
+#include <bitstream/traits/integral_traits.h>
+#include <bitstream/traits/string_traits.h>
+
+#include <string>
+
+namespace bitstream::test
+{
+	struct entity_definition
+	{
+		std::string name;
+		uint32_t max_health;
+
+		static inline uint32_t num_serializations = 0;
+	};
+}
+
+namespace bitstream
+{
+	template<>
+	struct serialize_traits<bitstream::test::entity_definition>
+	{
+		template<typename Stream>
+		static bool serialize(Stream& stream, inout<Stream, bitstream::test::entity_definition> value)
+		{
+			bitstream::test::entity_definition::num_serializations++;
+
+			BS_ASSERT(stream.template serialize<std::string>(value.name, 64U));
+
+			return stream.template serialize<uint32_t>(value.max_health, 0U, 100000U);
+		}
+	};
+}
+
+namespace bitstream::test::traits
+{
+	BS_ADD_TEST(test_serialize_cached)
+	{
+		using trait = cached<entity_definition>;
+
+		entity_definition definition{ "Heavy tank of doom", 25000U };
+
+		entity_definition::num_serializations = 0;
+
+		// Test that the object is only serialized once, and that the cached bits are the same at any bit offset
+		serialize_cache cache;
+
+		byte_buffer<256> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(cache, &definition, 1U, definition));
+		BS_TEST_ASSERT(writer.serialize_bits(5U, 3U));
+		BS_TEST_ASSERT(writer.serialize<trait>(cache, &definition, 1U, definition));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(entity_definition::num_serializations, == , 1U);
+
+
+		entity_definition definition_out[2];
+		uint32_t separator;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(cache, &definition, 1U, definition_out[0]));
+		BS_TEST_ASSERT(reader.serialize_bits(separator, 3U));
+		BS_TEST_ASSERT(reader.serialize<entity_definition>(definition_out[1]));
+
+		BS_TEST_ASSERT_OPERATION(separator, == , 5U);
+
+		for (int i = 0; i < 2; i++)
+		{
+			BS_TEST_ASSERT(definition_out[i].name == definition.name);
+			BS_TEST_ASSERT_OPERATION(definition_out[i].max_health, == , definition.max_health);
+		}
+	}
+
+	BS_ADD_TEST(test_serialize_cached_invalidate)
+	{
+		using trait = cached<entity_definition>;
+
+		entity_definition definition{ "Scout", 100U };
+
+		entity_definition::num_serializations = 0;
+
+		serialize_cache cache;
+
+		bit_measure measure(1024U);
+
+		// Test that changing the version or invalidating the object serializes it again
+		BS_TEST_ASSERT(measure.serialize<trait>(cache, &definition, 1U, definition));
+
+		definition.max_health = 120U;
+
+		BS_TEST_ASSERT(measure.serialize<trait>(cache, &definition, 2U, definition));
+		BS_TEST_ASSERT(measure.serialize<trait>(cache, &definition, 2U, definition));
+		BS_TEST_ASSERT_OPERATION(entity_definition::num_serializations, == , 2U);
+
+		definition.name = "Fast scout";
+		cache.invalidate(&definition);
+
+		BS_TEST_ASSERT(measure.serialize<trait>(cache, &definition, 2U, definition));
+		BS_TEST_ASSERT_OPERATION(entity_definition::num_serializations, == , 3U);
+
+		// The cached bits should be the same as serializing the object directly
+		bit_measure direct_measure(1024U);
+		BS_TEST_ASSERT(direct_measure.serialize<entity_definition>(definition));
+
+		uint32_t num_bits = measure.get_num_bits_serialized();
+		BS_TEST_ASSERT(measure.serialize<trait>(cache, &definition, 2U, definition));
+		BS_TEST_ASSERT_OPERATION(measure.get_num_bits_serialized() - num_bits, == , direct_measure.get_num_bits_serialized());
+
+		cache.erase(&definition);
+		BS_TEST_ASSERT_OPERATION(cache.size(), == , 0U);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "../shared/assert.h"
+#include "../shared/test.h"
+#include "../shared/test_types.h"
+
+#include <bitstream/stream/bit_reader.h>
+#include <bitstream/stream/bit_writer.h>
+
+#include <bitstream/traits/delta_traits.h>
+
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace bitstream::test
+{
+	struct entity_vitals
+	{
+		uint32_t health;
+		uint32_t armor;
+
+		bool operator==(const entity_vitals& other) const noexcept
+		{
+			return health == other.health && armor == other.armor;
+		}
+	};
+
+	struct entity_state
+	{
+		entity_vitals vitals;
+		float speed;
+		std::string name;
+
+		bool operator==(const entity_state& other) const noexcept
+		{
+			return vitals == other.vitals && speed == other.speed && name == other.name;
+		}
+	};
+}
+
+namespace bitstream
+{
+	template<>
+	struct serialize_traits<bitstream::test::entity_vitals>
+	{
+		using stat_trait = bounded_int<uint32_t, 0U, 200U>;
+
+		template<typename Stream>
+		static bool serialize(Stream& stream, inout<Stream, bitstream::test::entity_vitals> value) noexcept
+		{
+			BS_ASSERT(stream.template serialize<stat_trait>(value.health));
+
+			return stream.template serialize<stat_trait>(value.armor);
+		}
+
+		template<typename Stream>
+		static bool serialize_delta(Stream& stream, inout<Stream, bitstream::test::entity_vitals> value, in<bitstream::test::entity_vitals> baseline) noexcept
+		{
+			BS_ASSERT(stream.template serialize<delta<stat_trait>>(value.health, baseline.health));
+
+			return stream.template serialize<delta<stat_trait>>(value.armor, baseline.armor);
+		}
+	};
+
+	template<>
+	struct serialize_traits<bitstream::test::entity_state>
+	{
+		static constexpr bounded_range speed_range = bounded_range(0.0f, 20.0f, 0.01f);
+
+		template<typename Stream>
+		static bool serialize(Stream& stream, inout<Stream, bitstream::test::entity_state> value)
+		{
+			BS_ASSERT(stream.template serialize<bitstream::test::entity_vitals>(value.vitals));
+			BS_ASSERT(stream.template serialize<bounded_range>(speed_range, value.speed));
+
+			return stream.template serialize<std::string>(value.name, 32U);
+		}
+
+		template<typename Stream>
+		static bool serialize_delta(Stream& stream, inout<Stream, bitstream::test::entity_state> value, in<bitstream::test::entity_state> baseline)
+		{
+			BS_ASSERT(stream.template serialize<delta<bitstream::test::entity_vitals>>(value.vitals, baseline.vitals));
+			BS_ASSERT(stream.template serialize<delta<bounded_range>>(speed_range, value.speed, baseline.speed));
+
+			return stream.template serialize<delta<std::string>>(value.name, baseline.name, 32U);
+		}
+	};
+}
+
+namespace bitstream::test::traits
+{
+	BS_ADD_TEST(test_serialize_delta_integral)
+	{
+		using trait = delta<bounded_int<uint32_t, 0U, 1000U>>;
+
+		// Test unchanged, slightly changed and wide integers
+		byte_buffer<32> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(500U, 500U));
+		BS_TEST_ASSERT_OPERATION(writer.get_num_bits_serialized(), == , 1U);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(501U, 500U));
+		BS_TEST_ASSERT_OPERATION(writer.get_num_bits_serialized(), == , 1U + 1U + 4U);
+
+		BS_TEST_ASSERT(writer.serialize<delta<int32_t>>(-7, 12, -100, 100));
+		BS_TEST_ASSERT(writer.serialize<delta<uint64_t>>(0x123456789ULL, 42ULL));
+		uint32_t num_bits = writer.flush();
+
+
+		uint32_t values_out[2];
+		int32_t signed_out;
+		uint64_t wide_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out[0], 500U));
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out[1], 500U));
+		BS_TEST_ASSERT(reader.serialize<delta<int32_t>>(signed_out, 12, -100, 100));
+		BS_TEST_ASSERT(reader.serialize<delta<uint64_t>>(wide_out, 42ULL));
+
+		BS_TEST_ASSERT_OPERATION(values_out[0], == , 500U);
+		BS_TEST_ASSERT_OPERATION(values_out[1], == , 501U);
+		BS_TEST_ASSERT_OPERATION(signed_out, == , -7);
+		BS_TEST_ASSERT_OPERATION(wide_out, == , 0x123456789ULL);
+	}
+
+#ifndef BS_DEBUG_BREAK // Failing to read would break into the debugger
+	BS_ADD_TEST(test_serialize_delta_integral_out_of_range)
+	{
+		using wide_trait = delta<int_range<uint32_t>>;
+		using trait = delta<bounded_int<uint32_t, 0U, 200U>>;
+
+		// Write a value which uses the same number of bits, but is past the maximum of the reader
+		byte_buffer<8> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<wide_trait>(int_range<uint32_t>(0U, 255U), 255U, 0U));
+		uint32_t num_bits = writer.flush();
+
+
+		uint32_t value_out = 0U;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(!reader.serialize<trait>(value_out, 0U));
+		BS_TEST_ASSERT_OPERATION(value_out, == , 0U);
+	}
+#endif // BS_DEBUG_BREAK
+
+	BS_ADD_TEST(test_serialize_delta_quantization)
+	{
+		using rotation_trait = delta<smallest_three<quaternion, 11>>;
+		using position_trait = delta<bounded_vector3<vector3>>;
+
+		bounded_range range(-100.0f, 100.0f, 0.01f);
+		bounded_range ranges[3]{ range, range, range };
+
+		quaternion rotation_baseline{ 0.0f, 0.0f, std::sin(0.5f), std::cos(0.5f) };
+		quaternion rotation_in{ 0.0f, 0.0f, std::sin(0.51f), std::cos(0.51f) };
+		vector3 position_baseline{ 1.0f, 2.0f, 3.0f };
+		vector3 position_in{ 1.0f, 2.02f, 3.0f };
+
+		// Test that changes below the precision count as unchanged
+		byte_buffer<64> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<delta<bounded_range>>(range, 4.001f, 4.0f));
+		BS_TEST_ASSERT(writer.serialize<rotation_trait>(rotation_baseline, rotation_baseline));
+		BS_TEST_ASSERT(writer.serialize<position_trait>(ranges, position_baseline, position_baseline));
+		BS_TEST_ASSERT_OPERATION(writer.get_num_bits_serialized(), == , 3U);
+
+		BS_TEST_ASSERT(writer.serialize<delta<bounded_range>>(range, 4.5f, 4.0f));
+		BS_TEST_ASSERT(writer.serialize<rotation_trait>(rotation_in, rotation_baseline));
+		BS_TEST_ASSERT(writer.serialize<position_trait>(ranges, position_in, position_baseline));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, < , 3U + 2U * range.get_bits_required() + 2U + 3U * 11U + 3U * range.get_bits_required());
+
+
+		float float_out[2];
+		quaternion rotation_out[2];
+		vector3 position_out[2];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<delta<bounded_range>>(range, float_out[0], 4.0f));
+		BS_TEST_ASSERT(reader.serialize<rotation_trait>(rotation_out[0], rotation_baseline));
+		BS_TEST_ASSERT(reader.serialize<position_trait>(ranges, position_out[0], position_baseline));
+		BS_TEST_ASSERT(reader.serialize<delta<bounded_range>>(range, float_out[1], 4.0f));
+		BS_TEST_ASSERT(reader.serialize<rotation_trait>(rotation_out[1], rotation_baseline));
+		BS_TEST_ASSERT(reader.serialize<position_trait>(ranges, position_out[1], position_baseline));
+
+		BS_TEST_ASSERT_OPERATION(float_out[0], == , 4.0f);
+		BS_TEST_ASSERT(std::abs(float_out[1] - 4.5f) <= 0.01f);
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			BS_TEST_ASSERT_OPERATION(rotation_out[0][i], == , rotation_baseline[i]);
+			BS_TEST_ASSERT(std::abs(rotation_out[1][i] - rotation_in[i]) <= 0.001f);
+		}
+
+		for (size_t i = 0; i < 3; i++)
+		{
+			BS_TEST_ASSERT_OPERATION(position_out[0][i], == , position_baseline[i]);
+			BS_TEST_ASSERT(std::abs(position_out[1][i] - position_in[i]) <= 0.01f);
+		}
+	}
+
+	BS_ADD_TEST(test_serialize_delta_string)
+	{
+		using bounded_trait = delta<bounded_string<const char*, 32U>>;
+
+		// Test c-style and modern strings
+		std::string name_baseline = "Mr. Dude";
+		std::string name_in = "Mrs. Dude";
+
+		byte_buffer<64> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<delta<const char*>>("Hello", "Hello", 32U));
+		BS_TEST_ASSERT(writer.serialize<bounded_trait>("World", "Hello"));
+		BS_TEST_ASSERT(writer.serialize<delta<std::string>>(name_in, name_baseline, 32U));
+		uint32_t num_bits = writer.flush();
+
+
+		char unchanged_out[32];
+		char changed_out[32];
+		std::string name_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<delta<const char*>>(unchanged_out, "Hello", 32U));
+		BS_TEST_ASSERT(reader.serialize<bounded_trait>(changed_out, "Hello"));
+		BS_TEST_ASSERT(reader.serialize<delta<std::string>>(name_out, name_baseline, 32U));
+
+		BS_TEST_ASSERT(std::strcmp(unchanged_out, "Hello") == 0);
+		BS_TEST_ASSERT(std::strcmp(changed_out, "World") == 0);
+		BS_TEST_ASSERT(name_out == name_in);
+	}
+
+	BS_ADD_TEST(test_serialize_delta_aggregate)
+	{
+		entity_state baseline{ { 100U, 50U }, 5.0f, "Mr. Dude" };
+		entity_state changed_in{ { 90U, 50U }, 5.0f, "Mr. Dude" };
+
+		// Test an unchanged aggregate, which should only cost a single bit
+		byte_buffer<64> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<delta<entity_state>>(baseline, baseline));
+		BS_TEST_ASSERT_OPERATION(writer.get_num_bits_serialized(), == , 1U);
+
+		// Test that a changed aggregate recurses into its fields
+		BS_TEST_ASSERT(writer.serialize<delta<entity_state>>(changed_in, baseline));
+		BS_TEST_ASSERT_OPERATION(writer.get_num_bits_serialized(), == , 1U + (1U + (1U + (1U + 1U + 8U) + 1U) + 1U + 1U));
+		uint32_t num_bits = writer.flush();
+
+
+		entity_state unchanged_out;
+		entity_state changed_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<delta<entity_state>>(unchanged_out, baseline));
+		BS_TEST_ASSERT(reader.serialize<delta<entity_state>>(changed_out, baseline));
+
+		BS_TEST_ASSERT(unchanged_out == baseline);
+		BS_TEST_ASSERT(changed_out == changed_in);
+	}
+}
\ No newline at end of file
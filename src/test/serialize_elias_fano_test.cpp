@@ -0,0 +1,166 @@
+#include "../shared/assert.h"
+#include "../shared/test.h"
+
+#include <bitstream/stream/bit_reader.h>
+#include <bitstream/stream/bit_writer.h>
+
+#include <bitstream/traits/elias_fano_trait.h>
+
+namespace bitstream::test::traits
+{
+	BS_ADD_TEST(test_serialize_elias_fano)
+	{
+		using trait = elias_fano<uint32_t>;
+
+		// Test a sorted set of ids, with some duplicates and large gaps
+		uint32_t values_in[300];
+		for (uint32_t i = 0; i < 300; i++)
+			values_in[i] = i * i / 3 + (i > 200 ? 100000 : 0);
+
+		byte_buffer<1024> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 300U, 512U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, < , 300U * 16U);
+
+
+		uint32_t values_out[512];
+		uint32_t size_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, size_out, 512U));
+
+		BS_TEST_ASSERT_OPERATION(size_out, == , 300U);
+		BS_TEST_ASSERT_OPERATION(reader.get_num_bits_serialized(), == , num_bits);
+
+		for (uint32_t i = 0; i < 300; i++)
+			BS_TEST_ASSERT_OPERATION(values_out[i], == , values_in[i]);
+	}
+
+	BS_ADD_TEST(test_serialize_elias_fano_view)
+	{
+		using trait = elias_fano<uint64_t>;
+
+		// Test querying the sequence without decoding it
+		uint64_t values_in[200];
+		for (uint64_t i = 0; i < 200; i++)
+			values_in[i] = i * 1000 + (i % 7);
+
+		uint32_t trailing = 1337;
+
+		byte_buffer<1024> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 200U, 256U));
+		BS_TEST_ASSERT(writer.serialize_bits(trailing, 11U));
+		uint32_t num_bits = writer.flush();
+
+
+		elias_fano_view<uint64_t> view;
+		uint32_t trailing_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(view, 256U));
+		BS_TEST_ASSERT(reader.serialize_bits(trailing_out, 11U));
+
+		BS_TEST_ASSERT_OPERATION(trailing_out, == , trailing);
+		BS_TEST_ASSERT_OPERATION(view.size(), == , 200U);
+
+		for (uint32_t i = 0; i < 200; i++)
+			BS_TEST_ASSERT_OPERATION(view.access(i), == , values_in[i]);
+
+		BS_TEST_ASSERT_OPERATION(view.next_geq(0U), == , 0U);
+		BS_TEST_ASSERT_OPERATION(view.next_geq(1001U), == , 1U);
+		BS_TEST_ASSERT_OPERATION(view.next_geq(1002U), == , 2U);
+		BS_TEST_ASSERT_OPERATION(view.next_geq(150000U), == , 150U);
+		BS_TEST_ASSERT_OPERATION(view.next_geq(200000U), == , 200U);
+
+		BS_TEST_ASSERT(view.contains(42000U));
+		BS_TEST_ASSERT(!view.contains(42003U));
+		BS_TEST_ASSERT(view.contains(199003U));
+	}
+
+	BS_ADD_TEST(test_serialize_elias_fano_empty)
+	{
+		using trait = elias_fano<uint16_t>;
+
+		byte_buffer<4> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(nullptr, 0U, 16U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 5U);
+
+
+		elias_fano_view<uint16_t> view;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(view, 16U));
+
+		BS_TEST_ASSERT(view.empty());
+		BS_TEST_ASSERT(!view.contains(0U));
+	}
+
+#ifndef BS_DEBUG_BREAK // Failing to read would break into the debugger
+	BS_ADD_TEST(test_serialize_elias_fano_corrupted)
+	{
+		using trait = elias_fano<uint32_t>;
+
+		// Test that reading a corrupted sequence fails, instead of writing or reading out of bounds
+		uint32_t values_in[4] { 1U, 2U, 3U, 40U };
+
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 4U, 16U));
+		uint32_t num_bits = writer.flush();
+
+		// 5 bits of size, 32 bits of max, 4-bit one and zero samples, 3 low bits per value and 9 upper bits
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 66U);
+
+		auto corrupt = [&](uint32_t offset, uint32_t count, uint32_t value)
+		{
+			byte_buffer<16> corrupted = buffer;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t bit = offset + i;
+				uint8_t mask = static_cast<uint8_t>(0x80U >> (bit % 8U));
+
+				if ((value >> (count - 1U - i)) & 1U)
+					corrupted.Bytes[bit / 8U] |= mask;
+				else
+					corrupted.Bytes[bit / 8U] &= static_cast<uint8_t>(~mask);
+			}
+
+			struct
+			{
+				uint32_t values[4];
+				uint32_t guard = 0xDEADBEEFU;
+			} output;
+
+			uint32_t size_out;
+			fixed_bit_reader reader(corrupted, num_bits);
+
+			bool status = reader.serialize<trait>(output.values, size_out, 4U);
+
+			return !status && output.guard == 0xDEADBEEFU;
+		};
+
+		// Upper bits with more ones than the size
+		BS_TEST_ASSERT(corrupt(57U, 9U, 0x1FFU));
+
+		// Upper bits with fewer ones than the size
+		BS_TEST_ASSERT(corrupt(57U, 9U, 0x001U));
+
+		// A sampled position past the end of the upper bits
+		BS_TEST_ASSERT(corrupt(37U, 4U, 15U));
+
+		// Sampled positions inside the upper bits, but not matching them
+		BS_TEST_ASSERT(corrupt(37U, 4U, 1U));
+		BS_TEST_ASSERT(corrupt(41U, 4U, 8U));
+	}
+#endif // BS_DEBUG_BREAK
+}
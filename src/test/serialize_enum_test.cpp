@@ -56,4 +56,80 @@ namespace bitstream::test::traits
 
 		BS_TEST_ASSERT(out_value == value);
 	}
+
+	enum class message_type : uint8_t
+	{
+		Move,
+		Look,
+		Fire,
+		Reload,
+		Jump,
+		Crouch,
+		Chat,
+		Emote,
+		Spawn,
+		Despawn,
+		Connect,
+		Disconnect
+	};
+
+	BS_ADD_TEST(test_serialize_huffman_enum)
+	{
+		using huffman_type = huffman_enum<test_enum, 0, 10, 20, 70>;
+
+		// Test enums
+		test_enum values[4]{ test_enum::FirstValue, test_enum::SecondValue, test_enum::FirstValue, test_enum::ThirdValue };
+
+		// Write some enums, where the most frequent one only takes a single bit
+		byte_buffer<4> buffer;
+		fixed_bit_writer writer(buffer);
+
+		for (test_enum value : values)
+			BS_TEST_ASSERT(writer.serialize<huffman_type>(value));
+
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 1 + 2 + 1 + 2);
+
+		// Read the enums back and validate
+		fixed_bit_reader reader(buffer, num_bits);
+
+		for (test_enum value : values)
+		{
+			test_enum out_value;
+			BS_TEST_ASSERT(reader.serialize<huffman_type>(out_value));
+
+			BS_TEST_ASSERT(out_value == value);
+		}
+	}
+
+	BS_ADD_TEST(test_serialize_huffman_enum_long_codes)
+	{
+		// Each value is half as frequent as the last, so the rarest codes are too long for the lookup table
+		using huffman_type = huffman_enum<message_type, 2048, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2, 1>;
+
+		// Write every value, ending on the shortest code
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		for (uint8_t i = 12; i > 0; i--)
+			BS_TEST_ASSERT(writer.serialize<huffman_type>(static_cast<message_type>(i - 1)));
+
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 11 + 11 + 10 + 9 + 8 + 7 + 6 + 5 + 4 + 3 + 2 + 1);
+
+		// Read the values back and validate
+		fixed_bit_reader reader(buffer, num_bits);
+
+		for (uint8_t i = 12; i > 0; i--)
+		{
+			message_type out_value;
+			BS_TEST_ASSERT(reader.serialize<huffman_type>(out_value));
+
+			BS_TEST_ASSERT(out_value == static_cast<message_type>(i - 1));
+		}
+
+		BS_TEST_ASSERT_OPERATION(reader.get_remaining_bits(), == , 0);
+	}
 }
\ No newline at end of file
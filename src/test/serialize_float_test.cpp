@@ -7,6 +7,10 @@
 
 #include <bitstream/traits/float_trait.h>
 
+#include <cmath>
+#include <cstring>
+#include <limits>
+
 namespace bitstream::test::traits
 {
 	BS_ADD_TEST(test_serialize_float)
@@ -52,4 +56,88 @@ namespace bitstream::test::traits
 
 		BS_TEST_ASSERT_OPERATION(value_in, == , value_out);
 	}
+
+	BS_ADD_TEST(test_serialize_xor_float_sequence)
+	{
+		// Test a slowly changing signal, with runs of repeated samples
+		float values_in[256];
+		for (uint32_t i = 0; i < 256; i++)
+			values_in[i] = 20.0f + static_cast<float>(i / 4) * 0.125f;
+
+		byte_buffer<1024> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<xor_float_sequence>(values_in, 256U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, < , 256U * 32U / 4U);
+
+
+		float values_out[256];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<xor_float_sequence>(values_out, 256U));
+
+		for (int i = 0; i < 256; i++)
+			BS_TEST_ASSERT_OPERATION(values_out[i], == , values_in[i]);
+	}
+
+	BS_ADD_TEST(test_serialize_xor_float_sequence_exact)
+	{
+		// Test that special values and sign flips round-trip bit for bit
+		float values_in[10]
+		{
+			1.0f,
+			1.0f,
+			-0.0f,
+			0.0f,
+			std::numeric_limits<float>::quiet_NaN(),
+			std::numeric_limits<float>::infinity(),
+			-std::numeric_limits<float>::infinity(),
+			std::numeric_limits<float>::denorm_min(),
+			(std::numeric_limits<float>::max)(),
+			-3.5f
+		};
+
+		byte_buffer<128> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<xor_float_sequence>(values_in, 10U));
+		uint32_t num_bits = writer.flush();
+
+
+		float values_out[10];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<xor_float_sequence>(values_out, 10U));
+
+		BS_TEST_ASSERT(std::memcmp(values_in, values_out, sizeof(values_in)) == 0);
+		BS_TEST_ASSERT(std::isnan(values_out[4]));
+		BS_TEST_ASSERT(std::signbit(values_out[2]));
+	}
+
+	BS_ADD_TEST(test_serialize_xor_float_sequence_repeated)
+	{
+		// Test that repeated values only cost a single bit each
+		float values_in[100];
+		for (uint32_t i = 0; i < 100; i++)
+			values_in[i] = 9.81f;
+
+		byte_buffer<64> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<xor_float_sequence>(values_in, 100U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 32U + 99U);
+
+
+		float values_out[100];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<xor_float_sequence>(values_out, 100U));
+
+		for (int i = 0; i < 100; i++)
+			BS_TEST_ASSERT_OPERATION(values_out[i], == , values_in[i]);
+	}
 }
\ No newline at end of file
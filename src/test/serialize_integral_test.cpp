@@ -173,4 +173,191 @@ namespace bitstream::test::traits
 		test_const_integral<int64_t, -2147483648LL, 80LL>(-1073741824LL);
 	}
 #pragma endregion
-}
\ No newline at end of file
+
+#pragma region runtime integral range
+	template<typename T>
+	void test_range_integral(int_range<T> range, T value)
+	{
+		// Test integral numbers
+		byte_buffer<8> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<int_range<T>>(range, value));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , range.get_bits_required());
+
+
+		T out_value = 0;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<T>(out_value, range.get_min(), range.get_max())); // Same representation as runtime bounds
+
+		BS_TEST_ASSERT_OPERATION(out_value, == , value);
+	}
+
+	BS_ADD_TEST(test_serialize_uint16_range)
+	{
+		test_range_integral<uint16_t>(int_range<uint16_t>(20U, 400U), 131U);
+	}
+
+	BS_ADD_TEST(test_serialize_int32_range)
+	{
+		test_range_integral<int32_t>(int_range<int32_t>(-92060, 520), -65001);
+	}
+
+	BS_ADD_TEST(test_serialize_int64_range)
+	{
+		test_range_integral<int64_t>(int_range<int64_t>(-4398046511104LL, 128LL), -109951127776LL);
+	}
+
+	BS_ADD_TEST(test_serialize_range_deduction)
+	{
+		constexpr int_range<int16_t> range(-512, 2098);
+
+		// Test deducing the trait from the range
+		int16_t value = 1027;
+
+		byte_buffer<4> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize(range, value));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 12);
+
+
+		int16_t out_value;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize(range, out_value));
+
+		BS_TEST_ASSERT_OPERATION(out_value, == , value);
+	}
+#pragma endregion
+
+#pragma region 128-bit integral types
+	BS_ADD_TEST(test_serialize_uint64_word_order)
+	{
+		uint64_t value = 0x1234567890ULL;
+
+		// Test that wide ranges still store the lower word first
+		byte_buffer<8> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<uint64_t>(value, 0ULL, 0xFFFFFFFFFFULL));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 40);
+
+
+		uint32_t low;
+		uint32_t high;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize_bits(low, 32U));
+		BS_TEST_ASSERT(reader.serialize_bits(high, 8U));
+
+		BS_TEST_ASSERT_OPERATION(low, == , 0x34567890U);
+		BS_TEST_ASSERT_OPERATION(high, == , 0x12U);
+	}
+
+#ifdef BS_HAS_INT128
+	BS_ADD_TEST(test_serialize_uint128)
+	{
+		unsigned __int128 value = (static_cast<unsigned __int128>(0xFEDCBA9876543210ULL) << 64U) | 0x0123456789ABCDEFULL;
+
+		// Test the full range of a 128-bit integer
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<unsigned __int128>(value));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 128);
+
+
+		unsigned __int128 out_value = 0;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<unsigned __int128>(out_value));
+
+		BS_TEST_ASSERT(out_value == value);
+	}
+
+	BS_ADD_TEST(test_serialize_int128_range)
+	{
+		__int128 min = -(static_cast<__int128>(1) << 100U);
+		__int128 max = static_cast<__int128>(1) << 90U;
+		__int128 value = -(static_cast<__int128>(0x5A5A5A5A5A5AULL) << 50U);
+
+		// Test a signed 128-bit range
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<__int128>(value, min, max));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 101);
+
+
+		__int128 out_value = 0;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<__int128>(out_value, min, max));
+
+		BS_TEST_ASSERT(out_value == value);
+	}
+
+	BS_ADD_TEST(test_serialize_int128_const)
+	{
+		using trait = bounded_int<__int128, -(static_cast<__int128>(1) << 70U), static_cast<__int128>(1) << 70U>;
+
+		__int128 value = -(static_cast<__int128>(1) << 69U) + 3;
+
+		// Test a 128-bit integer with compiletime bounds
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(value));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 72);
+
+
+		__int128 out_value = 0;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(out_value));
+
+		BS_TEST_ASSERT(out_value == value);
+	}
+#endif // BS_HAS_INT128
+
+	BS_ADD_TEST(test_serialize_uint128_array)
+	{
+		using uint128_array = std::array<uint64_t, 2>;
+
+		uint128_array min{ 0x10ULL, 0xFFFFFFFFFFFFFF00ULL };
+		uint128_array max{ 0x8000000010ULL, 0x100ULL };
+		uint128_array value{ 0x4000000000ULL, 0x42ULL };
+
+		// Test the portable 128-bit representation
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<uint128_array>(value, min, max));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 103);
+
+
+		uint128_array out_value{};
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<uint128_array>(out_value, min, max));
+
+		BS_TEST_ASSERT(out_value == value);
+	}
+#pragma endregion
+}
@@ -0,0 +1,138 @@
+#include "../shared/assert.h"
+#include "../shared/test.h"
+#include "../shared/test_types.h"
+
+#include <bitstream/stream/bit_reader.h>
+#include <bitstream/stream/bit_writer.h>
+
+#include <bitstream/traits/predicted_traits.h>
+
+#include <cmath>
+
+namespace bitstream::test::traits
+{
+	BS_ADD_TEST(test_serialize_predicted_residual)
+	{
+		// Test every value against every prediction, which should never cost more than 1 extra bit
+		for (uint32_t prediction = 0; prediction < 256; prediction++)
+		{
+			for (uint32_t value_in = 0; value_in < 256; value_in++)
+			{
+				byte_buffer<16> buffer;
+				fixed_bit_writer writer(buffer);
+
+				BS_TEST_ASSERT(writer.serialize<predicted<uint32_t>>(value_in, prediction, 8U));
+				uint32_t num_bits = writer.flush();
+
+				BS_TEST_ASSERT_OPERATION(num_bits, <= , 9U);
+
+
+				uint32_t value_out;
+				fixed_bit_reader reader(buffer, num_bits);
+
+				BS_TEST_ASSERT(reader.serialize<predicted<uint32_t>>(value_out, prediction, 8U));
+
+				BS_TEST_ASSERT_OPERATION(value_out, == , value_in);
+			}
+		}
+
+		// Test that small residuals only cost a few bits
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<predicted<uint32_t>>(1000U, 1000U, 20U));
+		BS_TEST_ASSERT_OPERATION(writer.get_num_bits_serialized(), == , 2U);
+
+		BS_TEST_ASSERT(writer.serialize<predicted<uint32_t>>(999U, 1000U, 20U));
+		BS_TEST_ASSERT_OPERATION(writer.get_num_bits_serialized(), == , 2U + 4U);
+
+		BS_TEST_ASSERT(writer.serialize<predicted<uint32_t>>(0xFFFFFFFFU, 0U, 32U));
+		BS_TEST_ASSERT_OPERATION(writer.get_num_bits_serialized(), == , 2U + 4U + 33U);
+		uint32_t num_bits = writer.flush();
+
+
+		uint32_t values_out[3];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<predicted<uint32_t>>(values_out[0], 1000U, 20U));
+		BS_TEST_ASSERT(reader.serialize<predicted<uint32_t>>(values_out[1], 1000U, 20U));
+		BS_TEST_ASSERT(reader.serialize<predicted<uint32_t>>(values_out[2], 0U, 32U));
+
+		BS_TEST_ASSERT_OPERATION(values_out[0], == , 1000U);
+		BS_TEST_ASSERT_OPERATION(values_out[1], == , 999U);
+		BS_TEST_ASSERT_OPERATION(values_out[2], == , 0xFFFFFFFFU);
+	}
+
+	BS_ADD_TEST(test_serialize_predicted_vector3)
+	{
+		using trait = predicted<bounded_vector3<vector3>>;
+
+		// Test an entity moving in a straight line, predicted by extrapolating the previous two positions
+		bounded_range ranges[3]
+		{
+			bounded_range(-500.0f, 500.0f, 0.01f),
+			bounded_range(-10.0f, 100.0f, 0.01f),
+			bounded_range(-500.0f, 500.0f, 0.01f)
+		};
+
+		vector3 previous{ 10.0f, 2.0f, -30.0f };
+		vector3 current{ 10.5f, 2.0f, -29.75f };
+		vector3 value_in{ 11.0f, 2.0f, -29.5f };
+		vector3 prediction{ 2.0f * current[0] - previous[0], 2.0f * current[1] - previous[1], 2.0f * current[2] - previous[2] };
+
+		byte_buffer<32> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(ranges, value_in, prediction));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, <= , 3U * 4U);
+
+
+		vector3 value_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(ranges, value_out, prediction));
+
+		for (size_t i = 0; i < 3; i++)
+			BS_TEST_ASSERT(std::abs(value_out[i] - value_in[i]) <= 0.01f);
+	}
+
+	BS_ADD_TEST(test_serialize_predicted_quaternion)
+	{
+		using trait = predicted<smallest_three<quaternion, 11>>;
+		using rotation_trait = smallest_three<quaternion, 11>;
+
+		// Test a slowly turning rotation, as well as one where the largest component changes
+		quaternion prediction{ 0.0f, 0.0f, std::sin(0.5f), std::cos(0.5f) };
+		quaternion close_in{ 0.0f, 0.0f, std::sin(0.501f), std::cos(0.501f) };
+		quaternion far_in{ std::sin(1.2f), 0.0f, 0.0f, std::cos(1.2f) };
+
+		byte_buffer<32> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(close_in, prediction));
+		BS_TEST_ASSERT_OPERATION(writer.get_num_bits_serialized(), <= , 1U + 3U * 4U);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(far_in, prediction));
+		uint32_t num_bits = writer.flush();
+
+
+		quaternion close_out;
+		quaternion far_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(close_out, prediction));
+		BS_TEST_ASSERT(reader.serialize<trait>(far_out, prediction));
+
+		// The result should be the same as quantizing without a prediction
+		quaternion close_expected = rotation_trait::dequantize(rotation_trait::quantize(close_in));
+		quaternion far_expected = rotation_trait::dequantize(rotation_trait::quantize(far_in));
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			BS_TEST_ASSERT_OPERATION(close_out[i], == , close_expected[i]);
+			BS_TEST_ASSERT_OPERATION(far_out[i], == , far_expected[i]);
+		}
+	}
+}
\ No newline at end of file
@@ -35,6 +35,42 @@ namespace bitstream::test::traits
 		BS_TEST_ASSERT_OPERATION(std::abs(value_in - value_out), <=, epsilon);
 	}
 
+	BS_ADD_TEST(test_serialize_half_precision_array)
+	{
+		// Test an array of half-precision floats, which should be written the same as one float at a time
+		float values_in[70];
+		for (uint32_t i = 0; i < 70; i++)
+			values_in[i] = std::sin(static_cast<float>(i)) * 100.0f;
+
+		byte_buffer<256> single_buffer;
+		fixed_bit_writer single_writer(single_buffer);
+
+		for (uint32_t i = 0; i < 70; i++)
+			BS_TEST_ASSERT(single_writer.serialize<half_precision>(values_in[i]));
+		uint32_t single_bits = single_writer.flush();
+
+		byte_buffer<256> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<half_precision>(values_in, 70U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 70 * 16);
+		BS_TEST_ASSERT_OPERATION(num_bits, == , single_bits);
+
+		for (uint32_t i = 0; i < num_bits / 8; i++)
+			BS_TEST_ASSERT_OPERATION(buffer.Bytes[i], == , single_buffer.Bytes[i]);
+
+
+		float values_out[70];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<half_precision>(values_out, 70U));
+
+		for (uint32_t i = 0; i < 70; i++)
+			BS_TEST_ASSERT_OPERATION(std::abs(values_in[i] - values_out[i]), <= , 0.05f);
+	}
+
 	BS_ADD_TEST(test_serialize_bounded_range)
 	{
 		// Test bounded float
@@ -59,6 +95,140 @@ namespace bitstream::test::traits
 		BS_TEST_ASSERT_OPERATION(range.get_bits_required(), < , 32);
 	}
 
+	BS_ADD_TEST(test_serialize_bounded_range_array)
+	{
+		// Test an array of bounded floats, which should be written the same as one float at a time
+		float values_in[150];
+		for (uint32_t i = 0; i < 150; i++)
+			values_in[i] = std::sin(static_cast<float>(i)) * 2.5f + 2.5f;
+
+		constexpr bounded_range range(0.0f, 5.0f, 0.0001f);
+
+		byte_buffer<512> single_buffer;
+		fixed_bit_writer single_writer(single_buffer);
+
+		for (uint32_t i = 0; i < 150; i++)
+			BS_TEST_ASSERT(single_writer.serialize<bounded_range>(range, values_in[i]));
+		uint32_t single_bits = single_writer.flush();
+
+		byte_buffer<512> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<bounded_range>(range, values_in, 150U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 150 * 16);
+		BS_TEST_ASSERT_OPERATION(num_bits, == , single_bits);
+
+		for (uint32_t i = 0; i < num_bits / 8; i++)
+			BS_TEST_ASSERT_OPERATION(buffer.Bytes[i], == , single_buffer.Bytes[i]);
+
+
+		float values_out[150];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<bounded_range>(range, values_out, 150U));
+
+		for (uint32_t i = 0; i < 150; i++)
+			BS_TEST_ASSERT_OPERATION(std::abs(values_in[i] - values_out[i]), <= , range.get_precision());
+	}
+
+	BS_ADD_TEST(test_serialize_bounded_range_d)
+	{
+		// Test bounded double, with a padding so the value crosses a word boundary
+		uint32_t padding = 5;
+		double value_in = -98765.4321;
+		constexpr bounded_range_d range(-1000000.0, 1000000.0, 0.0001);
+
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize_bits(padding, 3));
+		BS_TEST_ASSERT(writer.serialize<bounded_range_d>(range, value_in));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 3 + 35);
+
+
+		uint32_t out_padding;
+		double value_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize_bits(out_padding, 3));
+		BS_TEST_ASSERT(reader.serialize<bounded_range_d>(range, value_out));
+
+		BS_TEST_ASSERT_OPERATION(out_padding, == , padding);
+		BS_TEST_ASSERT_OPERATION(std::abs(value_in - value_out), <= , range.get_precision());
+	}
+
+	BS_ADD_TEST(test_serialize_bounded_ratio)
+	{
+		using trait = bounded_ratio<std::ratio<0>, std::ratio<5>, std::ratio<1, 10000>>;
+
+		// Test a compile-time bounded float, which should be written the same as a bounded_range
+		float value_in = 3.141592f;
+		constexpr bounded_range range(0.0f, 5.0f, 0.0001f);
+
+		static_assert(serialize_traits<trait>::range.get_bits_required() == 16);
+
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(value_in));
+		BS_TEST_ASSERT(writer.serialize<bounded_range>(range, value_in));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 32);
+
+
+		float value_out;
+		float range_value_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<bounded_range>(range, value_out));
+		BS_TEST_ASSERT(reader.serialize<trait>(range_value_out));
+
+		BS_TEST_ASSERT_OPERATION(value_out, == , range_value_out);
+		BS_TEST_ASSERT_OPERATION(std::abs(value_in - value_out), <= , range.get_precision());
+	}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+	BS_ADD_TEST(test_serialize_bounded_float)
+	{
+		using trait = bounded_float<-10.0f, 10.0f, 0.01f>;
+
+		// Test an array of compile-time bounded floats
+		float values_in[10];
+		for (uint32_t i = 0; i < 10; i++)
+			values_in[i] = static_cast<float>(i) * 2.5f - 12.0f;
+
+		byte_buffer<64> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 10U));
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in[3]));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 11 * 11);
+
+
+		float values_out[10];
+		float value_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 10U));
+		BS_TEST_ASSERT(reader.serialize<trait>(value_out));
+
+		// Values outside the range are clamped
+		BS_TEST_ASSERT_OPERATION(values_out[0], == , -10.0f);
+		for (uint32_t i = 1; i < 9; i++)
+			BS_TEST_ASSERT_OPERATION(std::abs(values_in[i] - values_out[i]), <= , 0.01f);
+		BS_TEST_ASSERT_OPERATION(values_out[9], == , 10.0f);
+
+		BS_TEST_ASSERT_OPERATION(value_out, == , values_out[3]);
+	}
+#endif // __cpp_nontype_template_args
+
 	BS_ADD_TEST(test_serialize_smallest_three)
 	{
 		using trait = smallest_three<quaternion, 11>;
@@ -89,4 +259,197 @@ namespace bitstream::test::traits
 
 		BS_TEST_ASSERT_OPERATION(dot, >= , (1.0f - epsilon));
 	}
-}
\ No newline at end of file
+
+	BS_ADD_TEST(test_serialize_smallest_three_array)
+	{
+		using trait = smallest_three<quaternion, 11>;
+
+		// Test an array of quaternions, which should be written the same as one quaternion at a time
+		quaternion values_in[50];
+		for (uint32_t i = 0; i < 50; i++)
+		{
+			float angle = static_cast<float>(i) * 0.3f;
+			values_in[i] = quaternion{ std::cos(angle) * 0.6f, std::sin(angle) * 0.6f, (i % 2 == 0 ? 0.8f : -0.8f), 0.0f };
+		}
+
+		byte_buffer<512> single_buffer;
+		fixed_bit_writer single_writer(single_buffer);
+
+		for (uint32_t i = 0; i < 50; i++)
+			BS_TEST_ASSERT(single_writer.serialize<trait>(values_in[i]));
+		uint32_t single_bits = single_writer.flush();
+
+		byte_buffer<512> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 50U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 50 * (11 * 3 + 2));
+		BS_TEST_ASSERT_OPERATION(num_bits, == , single_bits);
+
+		for (uint32_t i = 0; i < num_bits / 8; i++)
+			BS_TEST_ASSERT_OPERATION(buffer.Bytes[i], == , single_buffer.Bytes[i]);
+
+
+		quaternion values_out[50];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 50U));
+
+		for (uint32_t i = 0; i < 50; i++)
+		{
+			float dot = values_in[i][0] * values_out[i][0] + values_in[i][1] * values_out[i][1] + values_in[i][2] * values_out[i][2] + values_in[i][3] * values_out[i][3];
+
+			BS_TEST_ASSERT_OPERATION(std::abs(dot), >= , 0.999f);
+		}
+	}
+
+	BS_ADD_TEST(test_serialize_bounded_vector3)
+	{
+		using trait = bounded_vector3<vector3>;
+
+		// Test a vector, which should be written the same as one axis at a time
+		vector3 value_in{ 12.34f, -5.5f, 700.0f };
+		const bounded_range ranges[3]
+		{
+			bounded_range(-100.0f, 100.0f, 0.01f),
+			bounded_range(-10.0f, 10.0f, 0.001f),
+			bounded_range(0.0f, 1000.0f, 0.1f)
+		};
+
+		byte_buffer<32> single_buffer;
+		fixed_bit_writer single_writer(single_buffer);
+
+		for (uint32_t i = 0; i < 3; i++)
+			BS_TEST_ASSERT(single_writer.serialize<bounded_range>(ranges[i], value_in[i]));
+		uint32_t single_bits = single_writer.flush();
+
+		byte_buffer<32> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(ranges, value_in));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 15 + 15 + 14);
+		BS_TEST_ASSERT_OPERATION(num_bits, == , single_bits);
+
+		for (uint32_t i = 0; i < 8; i++)
+			BS_TEST_ASSERT_OPERATION(buffer.Bytes[i], == , single_buffer.Bytes[i]);
+
+
+		vector3 value_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(ranges, value_out));
+
+		for (uint32_t i = 0; i < 3; i++)
+			BS_TEST_ASSERT_OPERATION(std::abs(value_in[i] - value_out[i]), <= , ranges[i].get_precision());
+	}
+
+	BS_ADD_TEST(test_serialize_quantized_transform)
+	{
+		using trait = quantized_transform<vector3, quaternion, 11>;
+		using rotation_trait = smallest_three<quaternion, 11>;
+
+		// Test transforms with and without scale, which should be written the same as one field at a time
+		vector3 position_in{ 1024.5f, -3.25f, 77.0f };
+		quaternion rotation_in{ 0.0f, std::sin(2.0f), std::cos(2.0f), 0.0f };
+		vector3 scale_in{ 1.0f, 2.0f, 0.5f };
+
+		const bounded_range position_ranges[3]
+		{
+			bounded_range(-4096.0f, 4096.0f, 0.001f),
+			bounded_range(-100.0f, 100.0f, 0.001f),
+			bounded_range(-4096.0f, 4096.0f, 0.001f)
+		};
+		const bounded_range scale_ranges[3]
+		{
+			bounded_range(0.0f, 4.0f, 0.01f),
+			bounded_range(0.0f, 4.0f, 0.01f),
+			bounded_range(0.0f, 4.0f, 0.01f)
+		};
+
+		byte_buffer<64> single_buffer;
+		fixed_bit_writer single_writer(single_buffer);
+
+		for (uint32_t i = 0; i < 3; i++)
+			BS_TEST_ASSERT(single_writer.serialize<bounded_range>(position_ranges[i], position_in[i]));
+		BS_TEST_ASSERT(single_writer.serialize<rotation_trait>(rotation_in));
+		for (uint32_t i = 0; i < 3; i++)
+			BS_TEST_ASSERT(single_writer.serialize<bounded_range>(position_ranges[i], position_in[i]));
+		BS_TEST_ASSERT(single_writer.serialize<rotation_trait>(rotation_in));
+		for (uint32_t i = 0; i < 3; i++)
+			BS_TEST_ASSERT(single_writer.serialize<bounded_range>(scale_ranges[i], scale_in[i]));
+		uint32_t single_bits = single_writer.flush();
+
+		byte_buffer<64> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(position_ranges, position_in, rotation_in));
+		BS_TEST_ASSERT(writer.serialize<trait>(position_ranges, position_in, rotation_in, scale_ranges, scale_in));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 2 * (23 + 18 + 23 + 35) + 3 * 9);
+		BS_TEST_ASSERT_OPERATION(num_bits, == , single_bits);
+
+		for (uint32_t i = 0; i < num_bits / 8; i++)
+			BS_TEST_ASSERT_OPERATION(buffer.Bytes[i], == , single_buffer.Bytes[i]);
+
+
+		vector3 position_out;
+		quaternion rotation_out;
+		vector3 scale_out;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(position_ranges, position_out, rotation_out));
+		BS_TEST_ASSERT(reader.serialize<trait>(position_ranges, position_out, rotation_out, scale_ranges, scale_out));
+
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			BS_TEST_ASSERT_OPERATION(std::abs(position_in[i] - position_out[i]), <= , position_ranges[i].get_precision());
+			BS_TEST_ASSERT_OPERATION(std::abs(scale_in[i] - scale_out[i]), <= , scale_ranges[i].get_precision());
+		}
+
+		float dot = rotation_in[0] * rotation_out[0] + rotation_in[1] * rotation_out[1] + rotation_in[2] * rotation_out[2] + rotation_in[3] * rotation_out[3];
+
+		BS_TEST_ASSERT_OPERATION(std::abs(dot), >= , 0.999f);
+	}
+
+	BS_ADD_TEST(test_serialize_octahedral_normal)
+	{
+		using trait = octahedral_normal<vector3, 12>;
+
+		// Test unit vectors, one at a time and as an array
+		vector3 values_in[9];
+		for (uint32_t i = 0; i < 9; i++)
+		{
+			float angle = static_cast<float>(i) * 0.8f;
+			values_in[i] = vector3{ std::cos(angle) * 0.6f, std::sin(angle) * 0.6f, (i % 2 == 0 ? 0.8f : -0.8f) };
+		}
+
+		byte_buffer<128> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in[0]));
+		BS_TEST_ASSERT(writer.serialize<trait>(values_in, 9U));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 10 * 24);
+
+
+		vector3 value_out;
+		vector3 values_out[9];
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(value_out));
+		BS_TEST_ASSERT(reader.serialize<trait>(values_out, 9U));
+
+		for (uint32_t k = 0; k < 3; k++)
+			BS_TEST_ASSERT_OPERATION(value_out[k], == , values_out[0][k]);
+
+		for (uint32_t i = 0; i < 9; i++)
+			for (uint32_t k = 0; k < 3; k++)
+				BS_TEST_ASSERT_OPERATION(std::abs(values_in[i][k] - values_out[i][k]), <= , 1e-3f);
+	}
+}
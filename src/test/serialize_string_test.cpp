@@ -246,4 +246,29 @@ namespace bitstream::test::traits
 		BS_TEST_ASSERT_OPERATION(out_value, ==, value);
 	}
 #pragma endregion
+
+#ifdef BS_HAS_MEMORY_RESOURCE
+	BS_ADD_TEST(test_serialize_pmr_string)
+	{
+		// Test reading into a string which allocates from an arena
+		std::string value = "A string that is too long for small string optimization";
+
+		byte_buffer<128> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<std::string>(value, 64U));
+		uint32_t num_bits = writer.flush();
+
+		// The arena throws if it runs out, instead of using the heap
+		alignas(std::max_align_t) uint8_t arena_bytes[256];
+		std::pmr::monotonic_buffer_resource arena(arena_bytes, sizeof(arena_bytes), std::pmr::null_memory_resource());
+
+		std::pmr::string out_value(&arena);
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<std::pmr::string>(out_value, 64U));
+
+		BS_TEST_ASSERT(out_value == value.c_str());
+	}
+#endif // BS_HAS_MEMORY_RESOURCE
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "../shared/assert.h"
+#include "../shared/test.h"
+
+#include <bitstream/stream/bit_reader.h>
+#include <bitstream/stream/bit_writer.h>
+
+#include <bitstream/traits/delta_traits.h>
+
+#include <bitstream/utility/snapshot_history.h>
+
+namespace bitstream::test::snapshot
+{
+	BS_ADD_TEST(test_snapshot_history_acknowledge)
+	{
+		utility::snapshot_history<uint32_t, 8> history;
+
+		for (uint16_t sequence = 0; sequence < 6; sequence++)
+			history.insert(sequence) = sequence * 10U;
+
+		BS_TEST_ASSERT(!history.has_baseline());
+		BS_TEST_ASSERT(history.get_baseline() == nullptr);
+
+		// Test that the newest acknowledged snapshot becomes the baseline
+		BS_TEST_ASSERT(history.acknowledge(3));
+		BS_TEST_ASSERT(history.acknowledge(1));
+
+		BS_TEST_ASSERT(history.has_baseline());
+		BS_TEST_ASSERT_OPERATION(history.get_baseline_sequence(), == , 3U);
+		BS_TEST_ASSERT_OPERATION(*history.get_baseline(), == , 30U);
+		BS_TEST_ASSERT(history.is_acked(1));
+		BS_TEST_ASSERT(!history.is_acked(2));
+
+		// Test acknowledging with a mask of previous sequence numbers
+		history.acknowledge(5, 0b11U);
+
+		BS_TEST_ASSERT_OPERATION(history.get_baseline_sequence(), == , 5U);
+		BS_TEST_ASSERT(history.is_acked(4));
+		BS_TEST_ASSERT(history.is_acked(3));
+		BS_TEST_ASSERT(!history.is_acked(2));
+
+		// Test that the baseline is forgotten once it is replaced in the ring
+		for (uint16_t sequence = 6; sequence < 14; sequence++)
+			history.insert(sequence) = sequence * 10U;
+
+		BS_TEST_ASSERT(!history.has_baseline());
+		BS_TEST_ASSERT(history.find(5) == nullptr);
+		BS_TEST_ASSERT(!history.acknowledge(5));
+		BS_TEST_ASSERT_OPERATION(*history.find(13), == , 130U);
+
+		history.reset();
+
+		BS_TEST_ASSERT(history.find(13) == nullptr);
+	}
+
+	BS_ADD_TEST(test_snapshot_history_wrap_around)
+	{
+		utility::snapshot_history<uint32_t, 4> history;
+
+		// Test sequence numbers which wrap around
+		for (uint32_t i = 0; i < 4; i++)
+			history.insert(static_cast<uint16_t>(65534U + i)) = i;
+
+		BS_TEST_ASSERT(history.acknowledge(1));
+		BS_TEST_ASSERT(history.acknowledge(65535));
+
+		BS_TEST_ASSERT_OPERATION(history.get_baseline_sequence(), == , 1U);
+		BS_TEST_ASSERT_OPERATION(*history.get_baseline(), == , 3U);
+
+		BS_TEST_ASSERT(utility::sequence_greater_than(1, 65535));
+		BS_TEST_ASSERT(!utility::sequence_greater_than(65535, 1));
+		BS_TEST_ASSERT(!utility::sequence_greater_than(7, 7));
+	}
+
+	BS_ADD_TEST(test_snapshot_history_delta)
+	{
+		using trait = delta<bounded_int<uint32_t, 0U, 1000U>>;
+
+		utility::snapshot_history<uint32_t, 32> sent;
+		utility::snapshot_history<uint32_t, 32> received;
+
+		// Test sending a value against the newest acknowledged baseline, and reading it against the same snapshot
+		sent.insert(0) = 400U;
+		received.insert(0) = 400U;
+		BS_TEST_ASSERT(sent.acknowledge(0));
+
+		uint32_t value_in = 402U;
+
+		byte_buffer<16> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize<uint16_t>(sent.get_baseline_sequence()));
+		BS_TEST_ASSERT(writer.serialize<trait>(value_in, *sent.get_baseline()));
+		uint32_t num_bits = writer.flush();
+
+		sent.insert(1) = value_in;
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 16U + 1U + 6U);
+
+
+		uint16_t baseline_sequence;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize<uint16_t>(baseline_sequence));
+
+		const uint32_t* baseline = received.find(baseline_sequence);
+		BS_TEST_ASSERT(baseline != nullptr);
+
+		BS_TEST_ASSERT(reader.serialize<trait>(received.insert(1), *baseline));
+
+		BS_TEST_ASSERT_OPERATION(*received.find(1), == , value_in);
+	}
+}
\ No newline at end of file
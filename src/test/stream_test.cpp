@@ -6,6 +6,8 @@
 #include <bitstream/stream/bit_writer.h>
 #include <bitstream/utility/bits.h>
 
+#include <vector>
+
 namespace bitstream::test::stream
 {
     BS_ADD_TEST(test_serialize_fail)
@@ -74,6 +76,73 @@ namespace bitstream::test::stream
 		BS_TEST_ASSERT(out_value3 == in_value3);
 	}
 
+	BS_ADD_TEST(test_serialize_bits64)
+	{
+		// Test serializing 64-bit values
+		uint32_t in_value1 = 5;
+		uint64_t in_value2 = 0x1FEDCBA987654ULL;
+		uint64_t in_value3 = 0xFFFFFFFFFFFFFFFFULL;
+
+		// Write a few bits to misalign the stream, then some wide values
+		byte_buffer<20> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize_bits(in_value1, 3));
+		BS_TEST_ASSERT(writer.serialize_bits(in_value2, 49));
+		BS_TEST_ASSERT(writer.serialize_bits(in_value3, 64));
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT(num_bits == 3 + 49 + 64);
+
+		// Read the values back and validate
+		uint32_t out_value1;
+		uint64_t out_value2;
+		uint64_t out_value3;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.serialize_bits(out_value1, 3));
+		BS_TEST_ASSERT(reader.serialize_bits(out_value2, 49));
+		BS_TEST_ASSERT(reader.serialize_bits(out_value3, 64));
+
+		BS_TEST_ASSERT(out_value1 == in_value1);
+		BS_TEST_ASSERT(out_value2 == in_value2);
+		BS_TEST_ASSERT(out_value3 == in_value3);
+	}
+
+	BS_ADD_TEST(test_serialize_peek)
+	{
+		// Test peeking at bits
+		uint32_t in_value1 = 0x2FU;
+		uint32_t in_value2 = 0x5U;
+
+		// Write a value that straddles a word
+		byte_buffer<8> buffer;
+		fixed_bit_writer writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize_bits(in_value1, 30));
+		BS_TEST_ASSERT(writer.serialize_bits(in_value2, 4));
+		uint32_t num_bits = writer.flush();
+
+		// Peek without advancing, then read the same bits
+		uint32_t peek_value;
+		uint32_t out_value1;
+		uint32_t out_value2;
+		fixed_bit_reader reader(buffer, num_bits);
+
+		BS_TEST_ASSERT(reader.peek_bits(peek_value, 30));
+		BS_TEST_ASSERT(reader.serialize_bits(out_value1, 30));
+		BS_TEST_ASSERT(peek_value == out_value1);
+
+		// Bits past the end of the buffer are peeked as zeros
+		BS_TEST_ASSERT(reader.peek_bits(peek_value, 8));
+		BS_TEST_ASSERT(peek_value == in_value2 << 4);
+
+		BS_TEST_ASSERT(reader.serialize_bits(out_value2, 4));
+
+		BS_TEST_ASSERT(out_value1 == in_value1);
+		BS_TEST_ASSERT(out_value2 == in_value2);
+	}
+
 	BS_ADD_TEST(test_serialize_padding_small)
 	{
 		// Test padding
@@ -344,6 +413,103 @@ namespace bitstream::test::stream
 		BS_TEST_ASSERT(out_nested_value3 == nested_value);
 	}
 
+	BS_ADD_TEST(test_serialize_nested_write_offsets)
+	{
+		// Test copying shared segments of every length into writers at every bit offset, with and without flushing the segment
+		for (uint32_t segment_bits = 1; segment_bits <= 100; segment_bits += 11)
+		{
+			for (uint32_t offset = 0; offset < 32; offset++)
+			{
+				for (int flushed = 0; flushed < 2; flushed++)
+				{
+					byte_buffer<32> segment_buffer;
+					fixed_bit_writer segment_writer(segment_buffer);
+
+					byte_buffer<64> expected_buffer;
+					fixed_bit_writer expected_writer(expected_buffer);
+
+					if (offset > 0)
+						BS_TEST_ASSERT(expected_writer.serialize_bits(0x5A5A5A5AU >> (32 - offset), offset));
+
+					for (uint32_t i = 0; i < segment_bits; i += 7)
+					{
+						uint32_t num_bits = (std::min)(segment_bits - i, 7U);
+						uint32_t value = (i * 37U + 11U) & ((1U << num_bits) - 1U);
+
+						BS_TEST_ASSERT(segment_writer.serialize_bits(value, num_bits));
+						BS_TEST_ASSERT(expected_writer.serialize_bits(value, num_bits));
+					}
+
+					BS_TEST_ASSERT(expected_writer.serialize_bits(3U, 2));
+
+					if (flushed)
+						segment_writer.flush();
+
+					byte_buffer<64> buffer;
+					fixed_bit_writer writer(buffer);
+
+					if (offset > 0)
+						BS_TEST_ASSERT(writer.serialize_bits(0x5A5A5A5AU >> (32 - offset), offset));
+
+					BS_TEST_ASSERT(segment_writer.serialize_into(writer));
+					BS_TEST_ASSERT(writer.serialize_bits(3U, 2));
+
+					uint32_t num_bits = writer.flush();
+					uint32_t expected_bits = expected_writer.flush();
+
+					BS_TEST_ASSERT_OPERATION(num_bits, == , expected_bits);
+
+					for (uint32_t i = 0; i < (num_bits + 31) / 32 * 4; i++)
+						BS_TEST_ASSERT_OPERATION(buffer.Bytes[i], == , expected_buffer.Bytes[i]);
+				}
+			}
+		}
+	}
+
+	BS_ADD_TEST(test_serialize_nested_write_fan_out)
+	{
+		// Test writing a shared segment into many writers, each with their own header
+		byte_buffer<16> shared_buffer;
+		fixed_bit_writer shared_writer(shared_buffer);
+
+		BS_TEST_ASSERT(shared_writer.serialize_bits(0xDEADBEEFU, 32));
+		BS_TEST_ASSERT(shared_writer.serialize_bits(0x1234U, 13));
+
+		byte_buffer<16> buffers[4];
+		fixed_bit_writer writers[4]
+		{
+			fixed_bit_writer(buffers[0]),
+			fixed_bit_writer(buffers[1]),
+			fixed_bit_writer(buffers[2]),
+			fixed_bit_writer(buffers[3])
+		};
+
+		for (uint32_t i = 0; i < 4; i++)
+			BS_TEST_ASSERT(writers[i].serialize_bits(i, i + 1));
+
+		BS_TEST_ASSERT(shared_writer.serialize_into(writers, 4));
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			uint32_t num_bits = writers[i].flush();
+
+			BS_TEST_ASSERT_OPERATION(num_bits, == , i + 1 + 45);
+
+			uint32_t header;
+			uint32_t first;
+			uint32_t second;
+			fixed_bit_reader reader(buffers[i], num_bits);
+
+			BS_TEST_ASSERT(reader.serialize_bits(header, i + 1));
+			BS_TEST_ASSERT(reader.serialize_bits(first, 32));
+			BS_TEST_ASSERT(reader.serialize_bits(second, 13));
+
+			BS_TEST_ASSERT_OPERATION(header, == , i);
+			BS_TEST_ASSERT_OPERATION(first, == , 0xDEADBEEFU);
+			BS_TEST_ASSERT_OPERATION(second, == , 0x1234U);
+		}
+	}
+
 	BS_ADD_TEST(test_serialize_nested_read)
 	{
 		// Test nested writers
@@ -419,4 +585,125 @@ namespace bitstream::test::stream
 		BS_TEST_ASSERT(writer.get_num_bits_serialized() == 5 + serialize_bits);
 		BS_TEST_ASSERT(writer.get_num_bytes_serialized() == 11);
 	}
+
+	BS_ADD_TEST(test_serialize_growing_size)
+	{
+		// Test that the container only grows by the number of words written
+		std::vector<uint32_t> buffer;
+		growing_bit_writer<std::vector<uint32_t>> writer(buffer);
+
+		BS_TEST_ASSERT(writer.serialize_bits(1U, 5));
+		BS_TEST_ASSERT_OPERATION(buffer.size(), == , 1U);
+
+		BS_TEST_ASSERT(writer.serialize_bits(0xFFFFFFFFU, 32));
+		BS_TEST_ASSERT(writer.serialize_bits(0xFFFFFFFFU, 28));
+		BS_TEST_ASSERT_OPERATION(buffer.size(), == , 3U);
+
+		uint32_t num_bits = writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 65U);
+	}
+
+	BS_ADD_TEST(test_serialize_small_buffer)
+	{
+		// Test that a small message is stored inside the writer
+		small_bit_writer<16> writer;
+
+		auto is_inline = [](const small_bit_writer<16>& writer)
+		{
+			const uint8_t* begin = reinterpret_cast<const uint8_t*>(&writer);
+			return writer.get_buffer() >= begin && writer.get_buffer() < begin + sizeof(writer);
+		};
+
+		for (uint32_t i = 0; i < 10; i++)
+			BS_TEST_ASSERT(writer.serialize_bits(i, 12));
+
+		BS_TEST_ASSERT(is_inline(writer));
+
+		// Moving should copy the inline bytes
+		small_bit_writer<16> moved_writer(std::move(writer));
+
+		BS_TEST_ASSERT(is_inline(moved_writer));
+
+		// Spill to the heap, with a value crossing the end of the inline storage
+		for (uint32_t i = 10; i < 100; i++)
+			BS_TEST_ASSERT(moved_writer.serialize_bits(i, 12));
+
+		BS_TEST_ASSERT(!is_inline(moved_writer));
+
+		// Moving should keep the heap buffer
+		small_bit_writer<16> heap_writer;
+		heap_writer = std::move(moved_writer);
+
+		BS_TEST_ASSERT(!is_inline(heap_writer));
+
+		BS_TEST_ASSERT(heap_writer.serialize_bits(4095U, 12));
+		uint32_t num_bits = heap_writer.flush();
+
+		BS_TEST_ASSERT_OPERATION(num_bits, == , 101U * 12U);
+
+
+		fixed_bit_reader reader(heap_writer.get_buffer(), num_bits);
+
+		for (uint32_t i = 0; i < 100; i++)
+		{
+			uint32_t value;
+			BS_TEST_ASSERT(reader.serialize_bits(value, 12));
+			BS_TEST_ASSERT_OPERATION(value, == , i);
+		}
+
+		uint32_t last_value;
+		BS_TEST_ASSERT(reader.serialize_bits(last_value, 12));
+		BS_TEST_ASSERT_OPERATION(last_value, == , 4095U);
+	}
+
+#ifdef BS_HAS_MEMORY_RESOURCE
+	BS_ADD_TEST(test_serialize_pmr_arena)
+	{
+		// Test writers allocating from an arena, which throws if it runs out instead of using the heap
+		alignas(uint32_t) uint8_t arena_bytes[4096];
+		std::pmr::monotonic_buffer_resource arena(arena_bytes, sizeof(arena_bytes), std::pmr::null_memory_resource());
+
+		for (uint32_t frame = 0; frame < 4; frame++)
+		{
+			// Several writers in the same frame
+			std::pmr::vector<uint32_t> buffers[4]
+			{
+				std::pmr::vector<uint32_t>(&arena),
+				std::pmr::vector<uint32_t>(&arena),
+				std::pmr::vector<uint32_t>(&arena),
+				std::pmr::vector<uint32_t>(&arena)
+			};
+
+			uint32_t num_bits[4];
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				pmr_bit_writer writer(buffers[i]);
+
+				for (uint32_t j = 0; j < 20; j++)
+					BS_TEST_ASSERT(writer.serialize_bits(frame * 100U + i * 20U + j, 13));
+
+				num_bits[i] = writer.flush();
+			}
+
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				fixed_bit_reader reader(buffers[i].data(), num_bits[i]);
+
+				for (uint32_t j = 0; j < 20; j++)
+				{
+					uint32_t value;
+					BS_TEST_ASSERT(reader.serialize_bits(value, 13));
+					BS_TEST_ASSERT_OPERATION(value, == , frame * 100U + i * 20U + j);
+				}
+			}
+
+			// Free the whole frame at once
+			for (auto& buffer : buffers)
+				buffer = std::pmr::vector<uint32_t>(&arena);
+
+			arena.release();
+		}
+	}
+#endif // BS_HAS_MEMORY_RESOURCE
 }
\ No newline at end of file